@@ -0,0 +1,177 @@
+// Benchmark for TimeFormat::parse: latency and heap allocations per parse,
+// against the regex and istringstream parser it replaced, and a check that
+// local times resolve to the same instant as mktime.
+//
+//   make bench
+//   ./bench/timeformat_bench [parses]
+//   TZ=America/New_York ./bench/timeformat_bench
+#include "core/TimeFormat.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::system_clock;
+
+namespace {
+    std::atomic<long> allocations{0};
+}
+
+// Every allocation in the process is counted, the standard library's included
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC pairs the inlined free with the builtin operator new it assumes
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#pragma GCC diagnostic pop
+
+namespace {
+    // The parser TimeFormat::parse replaced, minus its range checks:
+    // "+minutes" or "YYYY-MM-DD HH:MM" in local time
+    Clock::time_point legacyParse(const std::string& text) {
+        static const std::regex relative(R"(\+(\d+))");
+        std::smatch match;
+        if (std::regex_match(text, match, relative)) {
+            return Clock::now() + std::chrono::minutes(std::stoi(match[1]));
+        }
+
+        std::istringstream stream(text);
+        char dateDelim1, dateDelim2, timeDelim;
+        int year, month, day, hour, minute;
+        stream >> year >> dateDelim1 >> month >> dateDelim2 >> day >> hour >> timeDelim >> minute;
+        if (stream.fail()) {
+            return Clock::time_point{};
+        }
+
+        std::tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        tm.tm_min = minute;
+        tm.tm_isdst = -1;
+        return Clock::from_time_t(std::mktime(&tm));
+    }
+
+    // One in three relative, the rest absolute local times next year
+    std::vector<std::string> makeInputs(long long year) {
+        std::vector<std::string> inputs;
+        char buffer[64];
+        for (int i = 0; i < 1000; ++i) {
+            if (i % 3 == 0) {
+                inputs.push_back("+" + std::to_string(i));
+                continue;
+            }
+            std::snprintf(buffer, sizeof buffer, "%04lld-%02d-%02d %02d:%02d",
+                          year, 1 + i % 12, 1 + i % 28, i % 24, i % 60);
+            inputs.push_back(buffer);
+        }
+        return inputs;
+    }
+
+    template <typename Parse>
+    void measure(const char* name, const std::vector<std::string>& inputs, long count, Parse parse) {
+        long long checksum = 0;
+        long before = allocations.load();
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < count; ++i) {
+            checksum += parse(inputs[static_cast<size_t>(i) % inputs.size()]).time_since_epoch().count();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        long allocated = allocations.load() - before;
+
+        std::printf("%-20s %8.1f ns/parse  %5.2f allocations/parse  (%ld parses, checksum %lld)\n", name,
+                    std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count),
+                    static_cast<double>(allocated) / static_cast<double>(count), count, checksum & 0xff);
+    }
+
+    // Random local times 2000-2039; a repeated hour may resolve to its first
+    // occurrence where mktime picks the second, which is not a mismatch
+    long compareWithMktime(Clock::time_point now, long count) {
+        std::mt19937_64 random(42);
+        char buffer[32];
+        long mismatches = 0;
+        for (long i = 0; i < count; ++i) {
+            int year = 2000 + static_cast<int>(random() % 40);
+            int month = 1 + static_cast<int>(random() % 12);
+            int day = 1 + static_cast<int>(random() % 28);
+            int hour = static_cast<int>(random() % 24);
+            int minute = static_cast<int>(random() % 60);
+            std::snprintf(buffer, sizeof buffer, "%04d-%02d-%02d %02d:%02d", year, month, day, hour, minute);
+
+            Clock::time_point parsed;
+            const char* error = nullptr;
+            if (!TimeFormat::parse(buffer, now, parsed, &error)) {
+                std::printf("  %s: %s\n", buffer, error);
+                ++mismatches;
+                continue;
+            }
+
+            std::tm tm = {};
+            tm.tm_year = year - 1900;
+            tm.tm_mon = month - 1;
+            tm.tm_mday = day;
+            tm.tm_hour = hour;
+            tm.tm_min = minute;
+            tm.tm_isdst = -1;
+            auto expected = Clock::from_time_t(std::mktime(&tm));
+            bool sameLocalTime = parsed < expected && TimeFormat::local(parsed) == TimeFormat::local(expected);
+            if (parsed != expected && !sameLocalTime) {
+                if (mismatches < 3) {
+                    std::printf("  %s: parse %s, mktime %s\n", buffer, TimeFormat::local(parsed).c_str(),
+                                TimeFormat::local(expected).c_str());
+                }
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    long count = 2000000;
+    if (argc > 1) {
+        count = std::atol(argv[1]);
+        if (count <= 0) {
+            std::fprintf(stderr, "Usage: %s [parses]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    auto now = Clock::now();
+    auto inputs = makeInputs(TimeFormat::localYear(now) + 1);
+    const char* zone = std::getenv("TZ");
+    std::printf("TZ=%s\n", zone ? zone : "(system)");
+
+    measure("TimeFormat::parse", inputs, count, [now](const std::string& text) {
+        Clock::time_point parsed;
+        TimeFormat::parse(text, now, parsed);
+        return parsed;
+    });
+    // The old parser is several times slower, so it gets a tenth of the parses
+    measure("regex/istringstream", inputs, std::max(count / 10, 1L), legacyParse);
+
+    const long samples = 200000;
+    long mismatches = compareWithMktime(now, samples);
+    std::printf("mktime mismatches: %ld of %ld\n", mismatches, samples);
+    return mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -5,17 +5,37 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include <map>
+#include <sstream>
 #include <chrono>
 #include "../database/Database.hpp"
 #include "../core/Task.hpp"
 #include "../core/Scheduler.hpp"
+#include "../core/FireLedger.hpp"
+#include "../core/EventChecker.hpp"
+#include "../core/TimeFormat.hpp"
+#include "../core/TaskWriter.hpp"
 #include "../notifications/ConsoleNotification.hpp"
 #include "../notifications/EmailNotification.hpp"
+#include "../notifications/FileNotification.hpp"
+#include "../notifications/WebhookNotification.hpp"
+#include "../notifications/SocketNotification.hpp"
+#include "../notifications/NotificationDispatcher.hpp"
+#include "../notifications/NotificationOutbox.hpp"
+#include "../notifications/ChannelRegistry.hpp"
+#include "../notifications/PluginLoader.hpp"
+#include "../notifications/DeferredDelivery.hpp"
 #include "../database/Exceptions.hpp"
 
 // Command handler type
 using CommandHandler = std::function<void(const std::vector<std::string>&)>;
 
+// Outcome of the command being run, reported per command by --batch
+struct CommandStatus {
+    bool failed = false;
+    int taskId = 0;  // task the command created or changed
+};
+
 namespace TaskApp{
     void printTask(const Task& task);
     void handleError(const std::error_code& error);
@@ -26,6 +46,25 @@ void printHelp();
 std::vector<std::string> parseArguments(const std::string& input);
 std::string trimString(const std::string& str);
 std::chrono::system_clock::time_point parseDateTime(const std::string& dateTimeStr);
+std::shared_ptr<Notification> findNotifier(const std::string& channel);
+bool parseChannelList(const std::string& text, std::vector<std::string>& channels);
+std::string joinChannelList(const std::vector<std::string>& channels);
+bool isBuiltInChannel(const std::string& channel);
+std::string describeChannels();
+bool submitToChannel(const ChannelRegistry::Channel& channel, const Task& task, const std::string& message,
+                     NotificationPriority priority, std::shared_ptr<DeliveryReceipt> receipt = nullptr);
+bool deliverToChannel(const std::shared_ptr<ChannelRegistry::Channel>& channel, const Task& task,
+                      const std::string& message, NotificationPriority priority,
+                      std::shared_ptr<DeliveryReceipt> receipt = nullptr);
+// Console fallback for a reminder another channel could not take
+void showOnConsole(const Task& task, const std::string& message,
+                   NotificationPriority priority = NotificationPriority::Normal,
+                   std::shared_ptr<DeliveryReceipt> receipt = nullptr);
+// Adds a channel's sink to the dispatcher with the console as its fallback
+void attachSink(const std::shared_ptr<Notification>& sink, const std::string& channel);
+Scheduler::Callback makeNotificationCallback(const std::string& channels, NotificationPriority priority);
+// Returns how many reminders were re-armed
+size_t restoreScheduledNotifications();
 
 // Command handlers
 void handleAddTask(const std::vector<std::string>& args);
@@ -36,8 +75,74 @@ void handleCompleteTask(const std::vector<std::string>& args);
 void handleScheduleTask(const std::vector<std::string>& args);
 void handleCheckEvents(const std::vector<std::string>& args);
 void handleEmailSetup(const std::vector<std::string>& args);
+void handleRecipients(const std::vector<std::string>& args);
+void handleDigestSetup(const std::vector<std::string>& args);
+void handleOutbox(const std::vector<std::string>& args);
+void handleFileLogSetup(const std::vector<std::string>& args);
+void handleWebhookSetup(const std::vector<std::string>& args);
+void handleSocketSetup(const std::vector<std::string>& args);
+void handleBreaker(const std::vector<std::string>& args);
+void handleNotifyStats(const std::vector<std::string>& args);
+void handleLanes(const std::vector<std::string>& args);
+void handlePlugin(const std::vector<std::string>& args);
+void handleWindow(const std::vector<std::string>& args);
+void handleRateLimit(const std::vector<std::string>& args);
+void handleTemplate(const std::vector<std::string>& args);
 void handleExit(const std::vector<std::string>& args);
 void handleTestNotification(const std::vector<std::string>& args);
 
+// Runs command lines and reports each one as a JSON result line (line,
+// command, ok, id, output). Consecutive add/update/delete/complete commands
+// share one transaction, open for at most 250 ms or 1000 commands, and their
+// results are handed to the writer once it commits, so a failed commit is
+// reported against each. schedule arms its reminder in memory at once, so it
+// runs outside the group and its row is committed before it returns.
+class CommandBatch {
+public:
+    using Writer = std::function<void(int client, const std::string& result)>;
+
+    CommandBatch(std::map<std::string, CommandHandler> commandMap, Writer write);
+    ~CommandBatch();
+
+    CommandBatch(const CommandBatch&) = delete;
+    CommandBatch& operator=(const CommandBatch&) = delete;
+
+    // False for blank and comment (#) lines, which produce no result
+    bool run(int client, size_t line, const std::string& text);
+    // Commits and writes every pending result
+    void flush();
+    size_t getFailureCount() const;
+
+private:
+    struct PendingResult {
+        int client;
+        size_t line;
+        std::string command;
+        CommandStatus status;
+        std::string output;
+    };
+
+    std::map<std::string, CommandHandler> commandMap;
+    Writer write;
+    std::vector<PendingResult> pending;
+    std::ostringstream captured;
+    std::chrono::steady_clock::time_point groupStarted{};
+    size_t failures{0};
+};
+
+// Opens the database and starts the notification pipeline. Quiet keeps
+// stdout for command results: console reminders go to stderr and no
+// progress is printed.
+bool startServices(const std::string& dbPath, bool quiet);
+void startEventChecker();
+// Stops the checker, writes pending fires and commits any open transaction,
+// then gives queued notifications a short deadline to go out; the outbox
+// keeps its undelivered rows. Services can be started again afterwards.
+void stopServices();
+std::map<std::string, CommandHandler> makeCommandMap();
+
 // Main application entry point
-void runCLI(const std::string& dbPath);
\ No newline at end of file
+void runCLI(const std::string& dbPath);
+// Runs the commands in a file ("-" for stdin) without prompts, printing one
+// JSON result per command; returns the process exit code
+int runBatch(const std::string& dbPath, const std::string& source);
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+
+// Long-running mode: one process owns the database, the scheduler and the
+// notification sinks and serves commands over a Unix domain socket, so every
+// command runs against warm state instead of a fresh session.
+//
+// Protocol: a client writes command lines exactly as typed in the CLI, each
+// ending in '\n', and may send any number of them before reading. The daemon
+// answers every line, in order, with one JSON result line as printed by
+// --batch, whose "line" counts that connection's lines. Blank and # lines get
+// no answer. "exit" closes the connection after its answer and "shutdown"
+// stops the daemon. Writes that arrive together share one transaction.
+
+// Serves until shutdown, SIGINT or SIGTERM; returns the process exit code.
+// Not available on Windows.
+int runDaemon(const std::string& dbPath, const std::string& socketPath);
+
+// Pipelines stdin to a daemon and prints its answers as they arrive; exits
+// with 0 when every command succeeded
+int runClient(const std::string& socketPath);
\ No newline at end of file
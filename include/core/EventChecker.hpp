@@ -0,0 +1,41 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Scheduler.hpp"
+
+// Runs the scheduler's trigger check on a background thread, once on start
+// and then every interval. The thread waits on a condition variable between
+// checks, so stop() returns as soon as a check in progress finishes instead of
+// after the rest of the interval, and a stopped checker can be started again.
+class EventChecker {
+public:
+    explicit EventChecker(std::shared_ptr<Scheduler> scheduler,
+                          std::chrono::milliseconds interval = std::chrono::seconds(15));
+    ~EventChecker();
+
+    EventChecker(const EventChecker&) = delete;
+    EventChecker& operator=(const EventChecker&) = delete;
+
+    void start();
+    void stop();
+
+    std::chrono::milliseconds getInterval() const;
+    bool isRunning() const;
+
+private:
+    std::shared_ptr<Scheduler> scheduler;
+    std::chrono::milliseconds interval;
+
+    // Held through start() and stop(), joins included, so they never
+    // touch worker at the same time
+    std::mutex lifecycleMutex;
+    mutable std::mutex stateMutex;
+    std::condition_variable wakeup;
+    std::thread worker;
+    bool running{false};
+
+    void runWorker();
+};
\ No newline at end of file
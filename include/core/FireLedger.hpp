@@ -0,0 +1,56 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../database/Database.hpp"
+
+// Durable record of reminders that have fired. Each fire is reported here
+// once the reminder has been delivered; entries are buffered and written to
+// the fire_ledger table in one transaction per batch by a background thread,
+// so firing never waits on a database write. A reminder whose fire was not yet flushed when the process
+// died is re-armed on restart and fires again with the same idempotency key,
+// which lets sinks and their receivers drop the duplicate.
+class FireLedger {
+public:
+    explicit FireLedger(std::shared_ptr<Database> database);
+    ~FireLedger();
+
+    FireLedger(const FireLedger&) = delete;
+    FireLedger& operator=(const FireLedger&) = delete;
+
+    // Buffers the fire; never blocks on the database
+    void recordFired(int taskId, std::chrono::system_clock::time_point triggerTime);
+
+    // Writes everything buffered so far; false if the write failed
+    bool flush();
+
+    void start();
+    void stop();
+
+    bool setFlushPolicy(const std::chrono::milliseconds& interval, size_t maxBatch);
+
+    size_t getPendingCount() const;
+    size_t getFlushedCount() const;
+    std::chrono::milliseconds getFlushInterval() const;
+    size_t getMaxBatch() const;
+
+private:
+    std::shared_ptr<Database> db;
+
+    std::chrono::milliseconds flushInterval{200};
+    size_t maxBatch{256};
+
+    // flushMutex serialises writes; stateMutex guards the buffer and counters
+    std::mutex flushMutex;
+    mutable std::mutex stateMutex;
+    std::condition_variable wakeup;
+    std::vector<FiredReminder> pending;
+    size_t flushed{0};
+    std::thread worker;
+    bool running{false};
+
+    void runWorker();
+};
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <functional>
 #include <chrono>
 #include <vector>
+#include <mutex>
 #include "Task.hpp"
 #include "Result.hpp"
 
@@ -12,8 +13,17 @@ public:
     ~Scheduler();
 
     using Callback = std::function<void(const Task&, const std::string& message)>;
+    using Action = std::function<void()>;
 
     Result <bool> scheduleTask(const Task& task, Callback callback);
+    // Re-arms a reminder saved before a restart; overdue ones fire on the next
+    // check. Not subject to the concurrent task limit, which only bounds new
+    // reminders: every persisted one is restored
+    Result <bool> restoreTask(const Task& task, std::chrono::system_clock::time_point triggerTime, Callback callback);
+    // Runs action on the first check at or after time. For work that is not a
+    // task reminder, such as releasing deferred notifications; actions do not
+    // count against the concurrent task limit
+    Result <bool> scheduleAction(std::chrono::system_clock::time_point time, Action action);
     Result <bool> checkAndTriggerEvents();
     Result <bool> cancelTask(int taskId);
 
@@ -25,6 +35,7 @@ public:
     int getMaxConcurrentTasks() const;
     std::chrono::milliseconds getEventCheckInterval() const;
     size_t getPendingEventsCount() const;
+    size_t getPendingActionsCount() const;
 
 
 private:
@@ -38,9 +49,15 @@ struct Event {
         : triggerTime(time), callback(cb), task(t) {}
 };
 
+    // Guards events; callbacks are always invoked without holding it
+    mutable std::mutex eventsMutex;
     std::multimap<std::chrono::system_clock::time_point,Event> events;
+    std::multimap<std::chrono::system_clock::time_point, Action> actions;
     std::string defaultReminderMessage{"Task reminder"};
     int maxConcurrentTasks{10};
     std::chrono::milliseconds eventCheckInterval{1000};
-    
+
+    // Capped inserts fail once maxConcurrentTasks events are pending
+    Result <bool> insertEvent(const Task& task, std::chrono::system_clock::time_point triggerTime, Callback callback,
+                              bool capped);
 };
\ No newline at end of file
@@ -18,13 +18,18 @@ public:
     Task& operator=(Task&&) noexcept = default;
 
     int getId() const;
-    string getDescription() const;
+    const string& getDescription() const;
     std::chrono::system_clock::time_point getDueDate() const;
     std::chrono::system_clock::time_point getCreatedAt() const;
     bool isCompleted() const;
     void markCompleted();
     int getReminderMinutes() const;
     std::chrono::system_clock::time_point getReminderTime() const;
+    // The time the reminder being delivered was scheduled for, which keys
+    // its idempotency; getReminderTime() unless set. A reminder restored
+    // after the task changed keeps the time it was scheduled with.
+    std::chrono::system_clock::time_point getScheduledReminderTime() const;
+    void setScheduledReminderTime(const std::chrono::system_clock::time_point& time);
 
     bool setId(int id);
     bool setDescription(const string& description);
@@ -39,4 +44,5 @@ private:
     std::chrono::system_clock::time_point createdAt;
     int reminderMinutes;
     bool completed{false};
+    std::chrono::system_clock::time_point scheduledReminder{};
 };
@@ -0,0 +1,46 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include "../database/Database.hpp"
+
+// Formats task rows as a table, CSV or JSON. Rows are appended to one buffer
+// that goes to the stream in large blocks and is never flushed per row, so
+// listing many tasks into a pipe costs little more than the write itself.
+//   table: aligned columns with local times, then a count
+//   csv:   RFC 4180 with a header row, times in UTC ISO 8601
+//   json:  an array with one object per line, times in UTC ISO 8601
+class TaskWriter {
+public:
+    enum class Format {
+        Table,
+        Csv,
+        Json
+    };
+
+    static bool parseFormat(const std::string& name, Format& format);
+
+    TaskWriter(std::ostream& out, Format format);
+    // Finishes if finish() was not called
+    ~TaskWriter();
+
+    TaskWriter(const TaskWriter&) = delete;
+    TaskWriter& operator=(const TaskWriter&) = delete;
+
+    void write(const TaskRow& row);
+    // Closes the JSON array or adds the table footer and writes what is left
+    void finish();
+
+    size_t getCount() const;
+
+private:
+    static constexpr size_t FlushThreshold = 64 * 1024;
+
+    std::ostream& out;
+    Format format;
+    std::string buffer;
+    size_t count{0};
+    bool finished{false};
+
+    void writeHeader();
+    void writeBuffer();
+};
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <string_view>
+
+// Thread-safe timestamp formatting shared by the CLI and the notification
+// sinks. Never calls std::localtime: the local UTC offset comes from
+// localtime_r (localtime_s on Windows) and is cached per thread for the
+// current quarter hour, the boundary every modern timezone changes on, and
+// the date part is cached per day (UTC) or minute (local). Repeated stamps
+// in a burst or listing are then plain digit formatting. Parsing goes the
+// other way with the same cached offsets and no allocation.
+namespace TimeFormat {
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    // Local time, "YYYY-MM-DD HH:MM:SS" or, without seconds, "YYYY-MM-DD HH:MM"
+    void appendLocal(std::string& out, TimePoint time, bool withSeconds = true);
+    std::string local(TimePoint time, bool withSeconds = true);
+
+    // UTC ISO 8601, "YYYY-MM-DDTHH:MM:SSZ"
+    void appendIsoUtc(std::string& out, TimePoint time);
+
+    // UTC RFC 2822 as used in mail headers, "Fri, 17 Oct 2026 05:40:59 +0000"
+    void appendRfc2822(std::string& out, TimePoint time);
+
+    // Broken-down local time, for callers that need the fields
+    std::tm localTm(TimePoint time);
+
+    // Seconds east of UTC in effect at time
+    long utcOffset(TimePoint time);
+
+    // Local calendar year of time
+    long long localYear(TimePoint time);
+
+    // Parses a point in time, case-insensitively, relative to now:
+    //   ISO 8601 "YYYY-MM-DD[( |T)HH:MM[:SS[.fff]]][Z|+HH:MM|+HHMM|+HH]",
+    //     in local time when no offset is given
+    //   "+N" minutes, or "+N" with units s, m, h, d, w, combinable as "+1h30m"
+    //   "today", "tomorrow" or a weekday ("fri", "friday", "next friday"),
+    //     optionally followed by "HH:MM[:SS]"; the next such day that is not
+    //     already over, and "next" skips today
+    // Dates without a time mean midnight. On failure returns false and sets
+    // error to a static description.
+    bool parse(std::string_view text, TimePoint now, TimePoint& out, const char** error = nullptr);
+}
\ No newline at end of file
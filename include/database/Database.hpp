@@ -1,9 +1,51 @@
 #pragma once
 #include <sqlite3.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string_view>
 #include <vector>
+#include <chrono>
 #include "../core/Task.hpp"
 #include "../core/Result.hpp"
 
+// One row of the tasks table as read by streamTasks; description points into
+// SQLite's buffer and is only valid during the callback
+struct TaskRow {
+    int id;
+    std::string_view description;
+    int reminderMinutes;
+    std::int64_t createdAt;  // seconds since epoch
+    std::int64_t dueDate;    // seconds since epoch
+    bool completed;
+};
+
+// A notification waiting in the outbox, with the task snapshot it was fired for
+struct OutboxEntry {
+    int id;
+    std::string channel;
+    Task task;
+    std::string message;
+    int attempts;
+    std::chrono::system_clock::time_point nextAttempt;
+    int priority;  // delivery lane, 0 is the most urgent
+};
+
+// A reminder that was scheduled and is not yet in the fire ledger
+struct ScheduledNotification {
+    Task task;
+    std::string channels;
+    std::chrono::system_clock::time_point triggerTime;
+    int priority;
+};
+
+// A reminder that fired, as recorded in the fire ledger
+struct FiredReminder {
+    int taskId;
+    std::chrono::system_clock::time_point triggerTime;
+};
+
 class Database {
 public:
     Database(const std::string& dbPath);
@@ -16,9 +58,41 @@ public:
     Result<bool> updateTask(const Task& task);
     Result <bool> deleteTask(int taskId);
     Result <std::vector<Task>> getAllTasks();
+    // Empty when no task has that id
+    Result<std::optional<Task>> getTask(int taskId);
+    // Hands every task (or every pending one) to visit in id order without
+    // building Task objects; returns how many rows were visited
+    Result<size_t> streamTasks(bool pendingOnly, const std::function<void(const TaskRow&)>& visit);
     Result <std::vector<Task>> getPendingTasks();
     Result <std::vector<Task>> getDeletedTasks();
 
+    // Notification outbox
+    // Due entries come back most urgent priority first, then oldest first;
+    // an entry is first due at firstAttempt (now if not given)
+    Result<int> enqueueOutboxEntry(const std::string& channel, const Task& task, const std::string& message,
+                                   int priority = 1, std::chrono::system_clock::time_point firstAttempt = {});
+    Result<std::vector<OutboxEntry>> getDueOutboxEntries(std::chrono::system_clock::time_point now, int limit);
+    Result<bool> deleteOutboxEntry(int entryId);
+    Result<bool> rescheduleOutboxEntry(int entryId, int attempts,
+                                       std::chrono::system_clock::time_point nextAttempt,
+                                       const std::string& lastError);
+    Result<int> getOutboxCount();
+    Result<std::map<int, int>> getOutboxCountsByPriority();
+
+    // Scheduled reminders survive restarts until they are recorded as fired
+    Result<bool> saveScheduledNotification(int taskId, std::chrono::system_clock::time_point triggerTime,
+                                           const std::string& channels, int priority = 1);
+    Result<std::vector<ScheduledNotification>> getUnfiredNotifications();
+    Result<bool> recordFiredReminders(const std::vector<FiredReminder>& fired);
+    Result<int> getFiredCount();
+
+    // Groups the writes that follow on this connection into one commit;
+    // other connections wait (up to the busy timeout) until it is committed
+    Result<bool> beginTransaction();
+    Result<bool> commitTransaction();
+    Result<bool> rollbackTransaction();
+    bool inTransaction() const;
+
     bool setDatabasePath(const std::string& newPath);
     std::string getDatabasePath() const;
 
@@ -27,6 +101,8 @@ private:
     std::string dbPath;
 
     bool execute(const std::string& sql);
+    // Upgrades tables created by older versions
+    void addColumnIfMissing(const std::string& table, const std::string& column, const std::string& definition);
     Task taskFromStatement(sqlite3_stmt* stmt);
     bool isConnected();
 
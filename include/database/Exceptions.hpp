@@ -1,6 +1,8 @@
 #pragma once
+#include <chrono>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // Base exception class for the application
 class TaskAppException : public std::runtime_error {
@@ -62,6 +64,49 @@ public:
     explicit EmailDeliveryException(const std::string& message) : NotificationException("Email delivery failed: " + message) {}
 };
 
+class CircuitOpenException : public NotificationException {
+public:
+    explicit CircuitOpenException(const std::string& message) : NotificationException("Circuit open: " + message) {}
+};
+
+// Over a rate limit; the notification should be retried at getRetryTime()
+class RateLimitedException : public NotificationException {
+public:
+    RateLimitedException(const std::string& message, std::chrono::steady_clock::time_point retryAt)
+        : NotificationException("Rate limited: " + message), retryAt(retryAt) {}
+
+    std::chrono::steady_clock::time_point getRetryTime() const noexcept { return retryAt; }
+
+private:
+    std::chrono::steady_clock::time_point retryAt;
+};
+
+// Part of a batch was not delivered; the notifications at getFailedIndices()
+// failed, those at getDeferredIndices() were held back by a rate limit until
+// getRetryTime() without being attempted, and every other one was delivered
+class BatchDeliveryException : public NotificationException {
+public:
+    BatchDeliveryException(const std::string& message, std::vector<size_t> failedIndices,
+                           std::vector<size_t> deferredIndices = {},
+                           std::chrono::steady_clock::time_point retryAt = {})
+        : NotificationException("Batch delivery incomplete: " + message), failed(std::move(failedIndices)),
+          deferred(std::move(deferredIndices)), retryAt(retryAt) {}
+
+    const std::vector<size_t>& getFailedIndices() const noexcept { return failed; }
+    const std::vector<size_t>& getDeferredIndices() const noexcept { return deferred; }
+    std::chrono::steady_clock::time_point getRetryTime() const noexcept { return retryAt; }
+
+private:
+    std::vector<size_t> failed;
+    std::vector<size_t> deferred;
+    std::chrono::steady_clock::time_point retryAt;
+};
+
+class TemplateException : public NotificationException {
+public:
+    explicit TemplateException(const std::string& message) : NotificationException("Invalid template: " + message) {}
+};
+
 class SchemaException : public DatabaseException {
 public:
     explicit SchemaException(const std::string& message) : DatabaseException("Schema error: " + message) {}
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "DeliveryWindow.hpp"
+#include "Notification.hpp"
+
+// Notification channels by name. Each channel is a stable slot whose sink can
+// be configured, replaced or cleared at any time. Names are resolved to slots
+// once, when a reminder is scheduled; firing then only loads the slot's
+// current sink, with no lookup by name.
+class ChannelRegistry {
+public:
+    class Channel {
+    public:
+        Channel(std::string name, bool durable);
+
+        const std::string& getName() const noexcept;
+        // Durable channels are delivered through the outbox rather than a
+        // dispatcher queue
+        bool isDurable() const noexcept;
+
+        // Null while the channel is not configured
+        std::shared_ptr<Notification> getSink() const;
+        void setSink(std::shared_ptr<Notification> notification);
+
+        // Null when the channel may deliver at any time
+        std::shared_ptr<const DeliveryWindow> getWindow() const;
+        void setWindow(std::shared_ptr<const DeliveryWindow> deliveryWindow);
+
+    private:
+        std::string name;
+        bool durable;
+        std::atomic<std::shared_ptr<Notification>> sink;
+        std::atomic<std::shared_ptr<const DeliveryWindow>> window;
+    };
+
+    // Returns the existing channel of that name, or creates an unconfigured one
+    std::shared_ptr<Channel> add(const std::string& name, bool durable = false);
+    std::shared_ptr<Channel> find(const std::string& name) const;
+    std::shared_ptr<Notification> findSink(const std::string& name) const;
+    // Sets the sink of the named channel, creating the channel if needed
+    void bind(const std::string& name, std::shared_ptr<Notification> sink);
+
+    // Channel names in the order they were added
+    std::vector<std::string> getNames() const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<Channel>> channels;
+    std::map<std::string, std::shared_ptr<Channel>> byName;
+};
\ No newline at end of file
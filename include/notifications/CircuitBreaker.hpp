@@ -0,0 +1,55 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+
+// Per-sink circuit breaker. After failureThreshold consecutive failures the
+// circuit opens and requests are refused without touching the sink; once
+// openDuration has passed, up to halfOpenProbes requests are let through and
+// the first result decides whether the circuit closes again or re-opens.
+class CircuitBreaker {
+public:
+    enum class State {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    CircuitBreaker(int failureThreshold = 5,
+                   std::chrono::milliseconds openDuration = std::chrono::seconds(30),
+                   int halfOpenProbes = 1);
+
+    // False while the circuit is open or all half-open probes are in flight
+    bool allowRequest();
+    void recordSuccess();
+    void recordFailure();
+    // The admitted request was not attempted; frees a half-open probe slot
+    void cancelRequest();
+    void reset();
+
+    bool setFailureThreshold(int threshold);
+    bool setOpenDuration(const std::chrono::milliseconds& duration);
+    bool setHalfOpenProbes(int probes);
+
+    State getState() const;
+    int getFailureThreshold() const;
+    std::chrono::milliseconds getOpenDuration() const;
+    int getHalfOpenProbes() const;
+    int getConsecutiveFailures() const;
+    // When an open circuit will start admitting probes
+    std::chrono::steady_clock::time_point getRetryTime() const;
+
+    static std::string stateName(State state);
+
+private:
+    State state{State::Closed};
+    int failureThreshold;
+    std::chrono::milliseconds openDuration;
+    int halfOpenProbes;
+    int consecutiveFailures{0};
+    int probesInFlight{0};
+    std::chrono::steady_clock::time_point openedAt{};
+    mutable std::mutex mutex;
+
+    void open();
+};
\ No newline at end of file
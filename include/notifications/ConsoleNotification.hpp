@@ -1,6 +1,7 @@
 #pragma once
 #include "Notification.hpp"
 #include "../database/Exceptions.hpp"
+#include <mutex>
 #include <string>
 
 class ConsoleNotification : public Notification {
@@ -10,25 +11,40 @@ public:
     
     // Core notification method
     void sendNotification(const Task& task, const std::string& message) override;
+    // Formats the whole batch into one buffer and writes it at once
+    void sendNotificationBatch(const std::vector<NotificationRequest>& batch) override;
     
     // Configuration methods
     bool setColorOutput(bool useColor);
     bool setVerboseOutput(bool verbose);
     bool setNotificationSound(bool enable);
+    // Writes to stderr instead, keeping stdout free for command results
+    bool setStandardError(bool enable);
     
     // Getters
     bool isColorOutputEnabled() const noexcept;
     bool isVerboseOutputEnabled() const noexcept;
     bool isNotificationSoundEnabled() const noexcept;
+    bool isStandardErrorEnabled() const noexcept;
     
 private:
     bool colorOutput;
     bool verboseOutput;
     bool useSound;
     bool isInitialized;
+    bool useStandardError;
+    // Escape codes are only emitted when stdout is a terminal that understands them
+    bool colorSupported;
+
+    // Reused output buffer; one write per notification or batch
+    std::mutex outputMutex;
+    std::string outputBuffer;
     
     // Helper methods
     void validateInitialization() const;
     void validateTaskData(const Task& task) const;
     bool tryInitializeConsole();
+    void formatNotification(std::string& out, const Task& task, const std::string& message) const;
+    void formatDetails(std::string& out, const Task& task, const std::string& message, bool color) const;
+    void writeOutput(const std::string& out) const;
 };
\ No newline at end of file
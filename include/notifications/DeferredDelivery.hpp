@@ -0,0 +1,79 @@
+#pragma once
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "ChannelRegistry.hpp"
+#include "../core/Scheduler.hpp"
+
+// Holds notifications for channels whose delivery window is closed. However
+// many reminders a channel collects, its backlog is re-armed as a single
+// scheduler action at the window opening; from there it is released in
+// ticks at a bounded rate, most urgent first, instead of all at once.
+// Backlogs are kept in memory, like the dispatcher queues they feed; a held
+// reminder's receipt is only released with it, so one still held at shutdown
+// or a crash is not recorded as fired and is re-armed (and held again) on
+// restart.
+class DeferredDelivery {
+public:
+    using Clock = std::chrono::system_clock;
+    // Hands a released notification to its channel; false if it could not be
+    // queued, in which case it is retried on the next tick
+    using Submit = std::function<bool(const ChannelRegistry::Channel& channel, const NotificationRequest& request)>;
+
+    DeferredDelivery(std::shared_ptr<Scheduler> scheduler, Submit submit);
+
+    DeferredDelivery(const DeferredDelivery&) = delete;
+    DeferredDelivery& operator=(const DeferredDelivery&) = delete;
+
+    // Holds request until opensAt; false if the release could not be armed
+    bool defer(const std::shared_ptr<ChannelRegistry::Channel>& channel, NotificationRequest request,
+               Clock::time_point opensAt);
+
+    // For channels that defer durably on their own (the outbox): when the
+    // next notification held for opensAt should first be attempted, spaced
+    // out at the release rate
+    Clock::time_point reserveReleaseSlot(const ChannelRegistry::Channel& channel, Clock::time_point opensAt);
+
+    // Notifications released per second and channel once a window opens
+    bool setReleaseRate(double perSecond);
+    double getReleaseRate() const;
+
+    // Drops every held notification and cancels its receipt, for shutdown;
+    // returns how many were dropped
+    size_t abandon();
+
+    size_t getBacklog(const ChannelRegistry::Channel& channel) const;
+    // When the channel's backlog is next released; the epoch if it has none
+    Clock::time_point getReleaseTime(const ChannelRegistry::Channel& channel) const;
+
+private:
+    struct Backlog {
+        std::shared_ptr<ChannelRegistry::Channel> channel;
+        std::deque<NotificationRequest> pending;
+        Clock::time_point releaseAt{};
+        Clock::time_point lastRelease{};
+        bool armed{false};
+    };
+
+    struct ReleaseSlots {
+        Clock::time_point opensAt{};
+        size_t reserved{0};
+    };
+
+    std::shared_ptr<Scheduler> scheduler;
+    Submit submit;
+    mutable std::mutex mutex;
+    std::map<const ChannelRegistry::Channel*, Backlog> backlogs;
+    std::map<const ChannelRegistry::Channel*, ReleaseSlots> slots;
+    double releaseRate{10.0};
+    std::chrono::milliseconds releaseTick{1000};
+
+    // Caller holds mutex
+    bool arm(Backlog& backlog, Clock::time_point at);
+    // Caller holds mutex; cancels the receipts of everything pending
+    size_t drop(Backlog& backlog);
+    void release(const ChannelRegistry::Channel* key);
+};
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Per-sink delivery counters plus histograms of delivery latency and of how
+// long notifications waited in a queue. Recording is a handful of relaxed
+// atomic adds, so every delivery thread can record without locking; a
+// snapshot is a copy for reporting, not a consistent cut across counters.
+class DeliveryMetrics {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    // Log2 buckets of microseconds: bucket 0 holds 0 us, bucket i holds
+    // [2^(i-1), 2^i) us, and the last bucket everything from about 18 min up
+    static constexpr size_t BucketCount = 32;
+
+    struct Histogram {
+        std::array<std::uint64_t, BucketCount> buckets{};
+        std::uint64_t count{0};
+        std::uint64_t totalMicros{0};
+        std::uint64_t maxMicros{0};
+
+        double averageMs() const;
+        // Upper bound of the bucket holding the quantile (0..1), in ms
+        double percentileMs(double quantile) const;
+        double maxMs() const;
+    };
+
+    struct Snapshot {
+        // Notifications handed to the sink
+        std::uint64_t attempts{0};
+        std::uint64_t successes{0};
+        std::uint64_t failures{0};
+        // Held back by a rate limit, or refused by an open circuit breaker
+        std::uint64_t deferred{0};
+        std::uint64_t rejected{0};
+        Histogram latency;
+        Histogram queueAge;
+    };
+
+    void recordAttempts(std::uint64_t count);
+    // Every notification of a batch gets the batch's latency
+    void recordSuccesses(std::uint64_t count, Duration latency);
+    void recordFailures(std::uint64_t count);
+    void recordDeferred(std::uint64_t count);
+    void recordRejected(std::uint64_t count);
+    void recordQueueAge(Duration age);
+
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    struct AtomicHistogram {
+        std::array<std::atomic<std::uint64_t>, BucketCount> buckets{};
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> totalMicros{0};
+        std::atomic<std::uint64_t> maxMicros{0};
+
+        void record(Duration value, std::uint64_t times);
+        Histogram load() const;
+        void reset();
+    };
+
+    std::atomic<std::uint64_t> attempts{0};
+    std::atomic<std::uint64_t> successes{0};
+    std::atomic<std::uint64_t> failures{0};
+    std::atomic<std::uint64_t> deferred{0};
+    std::atomic<std::uint64_t> rejected{0};
+    AtomicHistogram latency;
+    AtomicHistogram queueAge;
+};
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+
+// A daily span of local time in which a channel may deliver, e.g.
+// 08:00-22:00. A window whose close is earlier than its open spans midnight
+// (22:00-06:00).
+class DeliveryWindow {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    // Minutes after local midnight; throws NotificationException if out of
+    // range or if open equals close
+    DeliveryWindow(int openMinute, int closeMinute);
+
+    // "HH:MM-HH:MM"; null if the text is not a valid window
+    static std::shared_ptr<const DeliveryWindow> parse(const std::string& text);
+
+    bool contains(TimePoint time) const;
+    // time itself while the window is open, otherwise when it next opens
+    TimePoint nextOpening(TimePoint time) const;
+
+    int getOpenMinute() const noexcept;
+    int getCloseMinute() const noexcept;
+    std::string toString() const;
+
+private:
+    int openMinute;
+    int closeMinute;
+};
\ No newline at end of file
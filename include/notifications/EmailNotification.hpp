@@ -1,25 +1,181 @@
 #pragma once
 #include "Notification.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
+typedef void CURL;
+struct curl_slist;
+
+// Sends reminders over SMTP. Messages are spread over a pool of persistent
+// SMTP sessions, each with its own connection and thread; a session sends its
+// messages one at a time in the order they were queued, and callers block
+// while every session's queue is full. sendNotification returns once its
+// message is accepted by the server, and sendNotificationBatch keeps all
+// sessions busy at once.
 class EmailNotification : public Notification {
 public:
     explicit EmailNotification(std::string recipient);
+    ~EmailNotification() override;
+
+    EmailNotification(const EmailNotification&) = delete;
+    EmailNotification& operator=(const EmailNotification&) = delete;
+
     void sendNotification(const Task& task, const std::string& message) override;
+    // Throws BatchDeliveryException naming the messages that were not sent,
+    // and those a per-recipient limit deferred
+    void sendNotificationBatch(const std::vector<NotificationRequest>& batch) override;
+    // The digest window while digest mode is on
+    std::chrono::milliseconds getHoldTime() const override;
 
+    // Recipients share one message with an RCPT TO per address
     bool setRecipient(const std::string& newRecipient);
+    bool setRecipients(const std::vector<std::string>& newRecipients);
+    bool addRecipient(const std::string& address);
+    bool removeRecipient(const std::string& address);
     bool setSmtpServer(const std::string& server);
     bool setSmtpPort(int port);
     bool setSenderEmail(const std::string& email);
+    bool setTimeout(const std::chrono::milliseconds& timeout);
+    // Changing either drains and closes the open sessions
+    bool setSessionCount(size_t count);
+    bool setMaxQueuedPerSession(size_t count);
 
     std::string getRecipient() const;
+    std::vector<std::string> getRecipients() const;
     std::string getSmtpServer() const;
     int getSmtpPort() const;
     std::string getSenderEmail() const;
+    std::chrono::milliseconds getTimeout() const;
+    size_t getSessionCount() const;
+    size_t getMaxQueuedPerSession() const;
+
+    // Delivery statistics
+    size_t getSentCount() const;
+    double getMessagesPerSecond() const;
+
+    // Send what is queued, then close the SMTP sessions; the next email opens new ones
+    void disconnect();
+
+    // Same rules as the former ^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}$ regex
+    static bool isValidAddress(std::string_view address);
+
+    // Digest mode: reminders are buffered per recipient and sent as one email
+    // by a background thread once the window has elapsed or maxReminders have
+    // accumulated
+    bool setDigestPolicy(const std::chrono::seconds& window, size_t maxReminders);
+    void disableDigest();
+    bool isDigestEnabled() const;
+    std::chrono::seconds getDigestWindow() const;
+    size_t getDigestMaxReminders() const;
+    size_t getPendingDigestCount() const;
+
+    // Send buffered digests whose window has elapsed or that are full (all
+    // of them if force); a digest that fails stays buffered
+    void flushDigests(bool force = false);
+
+    // Limit emails per recipient address; over the limit sendNotification
+    // throws RateLimitedException so the caller can defer the message
+    bool setRecipientRateLimit(double perSecond, size_t burst);
+    void disableRecipientRateLimit();
+    double getRecipientRate() const;
+    size_t getRecipientBurst() const;
 
 private:
-    std::string recipient;
+    // One message queued on or being sent by a session
+    struct Outgoing {
+        std::string payload;
+        size_t offset{0};
+        std::shared_ptr<curl_slist> envelope;
+        std::string to;
+        std::string url;
+        std::string mailFrom;
+        bool implicitTls{false};
+        std::chrono::milliseconds timeout{0};
+        bool done{false};
+        std::string error;
+    };
+
+    // A persistent SMTP connection; one message in flight at a time. libcurl
+    // waits for the reply to the end of a message body synchronously even
+    // under curl_multi, so each session runs on its own thread
+    struct Session {
+        CURL* handle{nullptr};
+        std::deque<Outgoing*> queue;
+        bool busy{false};
+        std::condition_variable wakeup;
+        std::thread worker;
+    };
+
+    // Validated recipients plus the envelope and header built from them,
+    // rebuilt only when the list changes; queued messages hold on to the
+    // envelope they were built with
+    std::vector<std::string> recipients;
+    std::shared_ptr<curl_slist> recipientEnvelope;
+    std::string recipientHeader;
     std::string smtpServer{"localhost"};
     int smtpPort{25};
     std::string senderEmail{"notification@example.com"};
+    std::chrono::milliseconds timeout{10000};
+
+    // Guards the configuration above, the limiters and the render buffer
+    mutable std::mutex sessionMutex;
+    // Per-address limiters, created on first use
+    double recipientRate{0.0};
+    size_t recipientBurst{0};
+    std::map<std::string, std::unique_ptr<RateLimiter>> recipientLimiters;
+    std::string renderBuffer;
+
+    // Session pool, started on first use; poolMutex guards everything below
+    // and poolChanged signals freed queue space and completed messages
+    size_t sessionCount{4};
+    size_t maxQueuedPerSession{64};
+    std::vector<std::unique_ptr<Session>> sessions;
+    bool stopping{false};
+    mutable std::mutex poolMutex;
+    std::condition_variable poolChanged;
+    std::mutex lifecycleMutex;
+    size_t inFlight{0};
+    size_t sentCount{0};
+    std::chrono::steady_clock::duration sendTime{};
+    std::chrono::steady_clock::time_point busySince{};
+
+    struct Digest {
+        std::vector<std::string> recipients;
+        std::chrono::steady_clock::time_point opened;
+        std::vector<NotificationRequest> entries;
+    };
+
+    // Digest buffers keyed by recipient header, flushed by digestThread
+    std::chrono::seconds digestWindow{0};
+    size_t digestMaxReminders{0};
+    std::map<std::string, Digest> digests;
+    mutable std::mutex digestMutex;
+    std::condition_variable digestWakeup;
+    std::thread digestThread;
+    bool stopDigest{false};
+
+    std::string buildSmtpUrl() const;
+    void buildMessage(std::string& out, const Task& task, const std::string& message);
+    void buildDigestMessage(std::string& out, const std::string& to, const std::vector<NotificationRequest>& entries);
+    void prepareOutgoing(Outgoing& outgoing, std::shared_ptr<curl_slist> envelope, const std::string& to);
+    void transmit(const std::vector<Outgoing*>& messages);
+    bool bufferDigest(NotificationRequest request);
+    void sendDigest(const std::string& to, std::vector<NotificationRequest> entries, const std::vector<std::string>& digestRecipients);
+    void acquireRecipientTokens(const std::vector<std::string>& addresses, size_t cost = 1);
+    void rebuildRecipientCache();
+    void runDigestFlusher();
+
+    void startSessions();
+    void stopSessions();
+    void runSession(Session& session);
+    std::string sendOnSession(Session& session, Outgoing& outgoing);
+    static size_t readOutgoing(char* buffer, size_t size, size_t count, void* userData);
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "Notification.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Appends one JSON record per fired reminder to a journal file. Records go
+// through an in-memory buffer, fsync is grouped by record count or time, and
+// the file is rotated (path.1 ... path.N) once it reaches maxFileSize.
+class FileNotification : public Notification {
+public:
+    explicit FileNotification(std::string path);
+    ~FileNotification() override;
+
+    FileNotification(const FileNotification&) = delete;
+    FileNotification& operator=(const FileNotification&) = delete;
+
+    void sendNotification(const Task& task, const std::string& message) override;
+    void sendNotificationBatch(const std::vector<NotificationRequest>& batch) override;
+
+    // Write buffered records and fsync them
+    void flush();
+
+    bool setSyncPolicy(const std::chrono::milliseconds& interval, size_t everyRecords);
+    bool setRotation(std::uintmax_t maxFileSize, int maxFiles);
+    bool setBufferSize(size_t bytes);
+
+    std::string getPath() const;
+    std::chrono::milliseconds getSyncInterval() const;
+    size_t getSyncEveryRecords() const;
+    std::uintmax_t getMaxFileSize() const;
+    int getMaxFiles() const;
+    size_t getUnsyncedRecords() const;
+
+private:
+    std::string path;
+    int fd{-1};
+    std::uintmax_t fileSize{0};
+
+    std::string writeBuffer;
+    size_t bufferSize{64 * 1024};
+    size_t unsyncedRecords{0};
+    std::chrono::milliseconds syncInterval{1000};
+    size_t syncEveryRecords{100};
+    std::uintmax_t maxFileSize{10 * 1024 * 1024};
+    int maxFiles{5};
+
+    // Background fsync for records left unsynced when the interval passes
+    mutable std::mutex mutex;
+    std::condition_variable syncWakeup;
+    std::thread syncThread;
+    bool stopSync{false};
+
+    void openFile();
+    void closeFile();
+    void appendRecord(const Task& task, const std::string& message);
+    void writeBuffered();
+    void syncLocked();
+    void rotateIfNeeded(size_t incoming);
+    void runSyncLoop();
+};
\ No newline at end of file
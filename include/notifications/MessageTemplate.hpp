@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../core/Task.hpp"
+
+// Notification text with {placeholder} fields. The text is parsed once into a
+// list of literal and field segments; rendering walks that list and appends
+// straight into the caller's buffer, so a warm buffer renders without
+// allocating.
+//
+// Placeholders: {id} {description} {due} {due_iso} {reminder} {status}
+// {message} {prefix} {now}. Use {{ and }} for literal braces.
+class MessageTemplate {
+public:
+    enum class Field {
+        Literal,
+        Id,
+        Description,
+        Due,
+        DueIso,
+        Reminder,
+        Status,
+        Message,
+        Prefix,
+        Now
+    };
+
+    // Throws TemplateException for unknown placeholders or unbalanced braces
+    explicit MessageTemplate(std::string text);
+
+    // Appends the rendered text to out
+    void render(std::string& out, const Task& task, std::string_view message, std::string_view prefix) const;
+
+    const std::string& getSource() const noexcept;
+    size_t getSegmentCount() const noexcept;
+
+private:
+    struct Segment {
+        Field field;
+        // Slice of literals, for Literal segments
+        size_t offset;
+        size_t length;
+    };
+
+    std::string source;
+    std::string literals;
+    std::vector<Segment> segments;
+
+    void addLiteral(std::string_view text);
+    static Field parseField(std::string_view name);
+};
\ No newline at end of file
@@ -1,15 +1,152 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "CircuitBreaker.hpp"
+#include "DeliveryMetrics.hpp"
+#include "MessageTemplate.hpp"
+#include "RateLimiter.hpp"
 #include "../core/Task.hpp"
 
+class NotificationDispatcher;
+
+// Delivery lanes, most urgent first; the value is the lane index
+enum class NotificationPriority : int {
+    High = 0,
+    Normal = 1,
+    Low = 2
+};
+
+constexpr size_t NotificationPriorityCount = 3;
+
+const char* priorityName(NotificationPriority priority);
+bool parsePriority(const std::string& name, NotificationPriority& priority);
+
+// Shared by the copies of one fired reminder, whichever channels they went
+// to. The completion runs when the last copy is released, once each has been
+// handed to its sink or to the outbox; a copy dropped undelivered cancels it,
+// which leaves the reminder to fire again after a restart.
+class DeliveryReceipt {
+public:
+    explicit DeliveryReceipt(std::function<void()> onComplete);
+    ~DeliveryReceipt();
+
+    DeliveryReceipt(const DeliveryReceipt&) = delete;
+    DeliveryReceipt& operator=(const DeliveryReceipt&) = delete;
+
+    void cancel() noexcept;
+    bool isCancelled() const noexcept;
+
+private:
+    std::function<void()> onComplete;
+    std::atomic<bool> cancelled{false};
+};
+
+// A notification waiting to be delivered
+struct NotificationRequest {
+    Task task;
+    std::string message;
+    // When it was queued, for the queue age metric
+    std::chrono::steady_clock::time_point queuedAt{};
+    NotificationPriority priority{NotificationPriority::Normal};
+    // The outbox entry it was read from, 0 for anything else
+    int outboxId{0};
+    // Released once the request has been handed to its sink
+    std::shared_ptr<DeliveryReceipt> receipt{};
+};
+
 class Notification {
 public:
     virtual void sendNotification(const Task& task, const std::string& message) = 0;
     virtual ~Notification() = default;
 
+    // Sinks that can emit several notifications at once override this; the
+    // default sends them one by one and throws BatchDeliveryException with
+    // the items that failed or that a rate limit deferred
+    virtual void sendNotificationBatch(const std::vector<NotificationRequest>& batch);
+
+    // Queue on the attached dispatcher and return immediately; without a
+    // dispatcher the notification is sent synchronously. The receipt is
+    // held until the notification has been handed to the sink.
+    bool submitNotification(const Task& task, const std::string& message,
+                            NotificationPriority priority = NotificationPriority::Normal,
+                            std::shared_ptr<DeliveryReceipt> receipt = nullptr);
+    bool isDispatched() const noexcept;
+
+    // Send through the sink's rate limiter and circuit breaker; throws
+    // RateLimitedException over the rate and CircuitOpenException while the
+    // circuit is open, in both cases without touching the sink
+    void deliverNotification(const Task& task, const std::string& message);
+    void deliverNotificationBatch(const std::vector<NotificationRequest>& batch);
+    CircuitBreaker& getCircuitBreaker() noexcept;
+    RateLimiter& getRateLimiter() noexcept;
+    // Counts and latencies of deliverNotification/deliverNotificationBatch
+    DeliveryMetrics& getMetrics() noexcept;
+
+    // Sinks that only buffer what they are handed (email digests) return the
+    // longest they hold a notification, and report it through the delivered
+    // handler once it has actually gone out; zero for sinks that have
+    // delivered by the time they return
+    virtual std::chrono::milliseconds getHoldTime() const;
+    using DeliveredHandler = std::function<void(const std::vector<NotificationRequest>& delivered)>;
+    void setDeliveredHandler(DeliveredHandler handler);
+
     virtual bool setNotificationPrefix(const std::string& prefix);
     virtual std::string getNotificationPrefix() const;
 
+    // Per-sink templates for the notification text; an empty text restores
+    // the sink's default and an invalid one is rejected
+    bool setSubjectTemplate(const std::string& text);
+    bool setBodyTemplate(const std::string& text);
+    std::string getSubjectTemplate() const;
+    std::string getBodyTemplate() const;
+
+    // Identifies one reminder of one task ("task-<id>-<scheduled reminder
+    // epoch seconds>"); a reminder fired again after a restart carries the
+    // same key
+    static std::string idempotencyKey(const Task& task);
+
+    // Appends value as a quoted, escaped JSON string
+    static void appendJsonString(std::string& out, std::string_view value);
+    // Appends time as a UTC ISO 8601 timestamp (YYYY-MM-DDTHH:MM:SSZ)
+    static void appendIsoTimestamp(std::string& out, std::chrono::system_clock::time_point time);
+
 protected:
     std::string notificationPrefix{"NOTIFICATION: "};
+
+    // Compiled templates, or null when the sink's default text applies
+    std::shared_ptr<const MessageTemplate> subjectTemplate() const;
+    std::shared_ptr<const MessageTemplate> bodyTemplate() const;
+
+    static void appendIdempotencyKey(std::string& out, const Task& task);
+    // For sinks with a hold time, once held notifications have gone out
+    void reportDelivered(const std::vector<NotificationRequest>& delivered);
+
+    // Sinks whose sendNotification only queues the request (webhook) return
+    // true and report each result through reportOutcome once it is known; the
+    // circuit breaker then counts those results rather than the hand-over, and
+    // a failure (error set) reaches the dispatcher's failure handler
+    virtual bool reportsOutcomes() const;
+    void reportOutcome(const Task& task, const std::string& message, const std::exception* error);
+
+private:
+    friend class NotificationDispatcher;
+    std::atomic<NotificationDispatcher*> dispatcher{nullptr};
+    CircuitBreaker circuitBreaker;
+    RateLimiter rateLimiter;
+    DeliveryMetrics metrics;
+
+    // Held while the handler runs, so clearing it waits for a call in progress
+    std::mutex deliveredMutex;
+    DeliveredHandler onDelivered;
+
+    mutable std::mutex templateMutex;
+    std::shared_ptr<const MessageTemplate> subject;
+    std::shared_ptr<const MessageTemplate> body;
 };
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Notification.hpp"
+
+// Delivers notifications off the caller's thread. Every registered sink gets
+// its own bounded queue and delivery thread, so a slow sink only ever delays
+// itself and the scheduler's trigger loop never waits on I/O. Each queue has
+// one lane per priority, so a backlog of low-priority notifications does not
+// hold up urgent ones.
+class NotificationDispatcher {
+public:
+    using FailureHandler = std::function<void(const Task& task, const std::string& message, const std::exception& error)>;
+    using LaneWeights = std::array<unsigned, NotificationPriorityCount>;
+
+    // Strict always takes the most urgent non-empty lane; Weighted shares
+    // delivery slots between backlogged lanes by weight, so no lane starves
+    enum class LanePolicy {
+        Strict,
+        Weighted
+    };
+
+    explicit NotificationDispatcher(size_t defaultQueueCapacity = 256);
+    ~NotificationDispatcher();
+
+    NotificationDispatcher(const NotificationDispatcher&) = delete;
+    NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+
+    // Sink management (queueCapacity 0 uses the default capacity)
+    bool addSink(const std::shared_ptr<Notification>& sink, size_t queueCapacity = 0);
+    // Queued notifications get up to 2 s to go out before the rest is dropped
+    bool removeSink(const Notification& sink);
+    bool setFailureHandler(const Notification& sink, FailureHandler handler);
+
+    // Hands a failure the sink found after delivery to the sink's failure
+    // handler; false if the sink is unknown or has no handler
+    bool reportSinkFailure(const Notification& sink, const Task& task, const std::string& message,
+                           const std::exception& error);
+
+    // Enqueue without blocking; false if the sink is unknown or the lane is full.
+    // The receipt is released once the notification has been handed to the
+    // sink, whether or not that failed, and cancelled if it is dropped.
+    bool submit(const Notification& sink, const Task& task, const std::string& message,
+                NotificationPriority priority = NotificationPriority::Normal,
+                std::shared_ptr<DeliveryReceipt> receipt = nullptr);
+
+    // Drain all queues and join the delivery threads. Notifications still
+    // queued at the deadline are dropped and their receipts cancelled; a
+    // delivery already handed to its sink is not interrupted.
+    void shutdown(std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    size_t getQueueDepth(const Notification& sink) const;
+    size_t getLaneDepth(const Notification& sink, NotificationPriority priority) const;
+    size_t getDroppedCount(const Notification& sink) const;
+    // How long the notification at the head of the sink's queue has waited
+    std::chrono::steady_clock::duration getOldestQueuedAge(const Notification& sink) const;
+    size_t getDefaultQueueCapacity() const;
+
+    // Most notifications handed to a sink in one batch
+    bool setMaxBatchSize(size_t size);
+    size_t getMaxBatchSize() const;
+
+    // Weights are per lane, most urgent first, and must be positive
+    void setLanePolicy(LanePolicy policy);
+    bool setLaneWeights(const LaneWeights& weights);
+    LanePolicy getLanePolicy() const;
+    LaneWeights getLaneWeights() const;
+
+private:
+    struct SinkQueue {
+        std::shared_ptr<Notification> sink;
+        size_t capacity;  // per lane
+        size_t maxBatch;
+        LanePolicy policy;
+        LaneWeights weights;
+        std::array<std::deque<NotificationRequest>, NotificationPriorityCount> lanes;
+        std::array<long, NotificationPriorityCount> credits{};  // weighted round robin state
+        FailureHandler onFailure;
+        size_t dropped{0};
+        bool stopping{false};
+        std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+        mutable std::mutex mutex;
+        std::condition_variable wakeup;
+        std::thread worker;
+    };
+
+    mutable std::mutex sinksMutex;
+    std::map<const Notification*, std::shared_ptr<SinkQueue>> sinks;
+    size_t defaultQueueCapacity;
+    size_t maxBatchSize{32};
+    LanePolicy lanePolicy{LanePolicy::Weighted};
+    LaneWeights laneWeights{8, 4, 1};
+
+    static void runDeliveryLoop(SinkQueue& queue);
+    static size_t pendingCount(const SinkQueue& queue);
+    static size_t nextLane(SinkQueue& queue);
+    static void reportFailure(const FailureHandler& onFailure, const NotificationRequest& request,
+                              const std::exception& error);
+    // The queue drains until its deadline, then drops what is left
+    static void markStopping(SinkQueue& queue, std::chrono::steady_clock::time_point deadline);
+    static void stopQueue(SinkQueue& queue, std::chrono::steady_clock::time_point deadline);
+    std::shared_ptr<SinkQueue> findQueue(const Notification& sink) const;
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Notification.hpp"
+#include "../database/Database.hpp"
+
+// Durable delivery for notification channels. Fired reminders are written to
+// the notification_outbox table, a worker thread delivers them, and a row is
+// only deleted once its sink reports success. Failed deliveries are retried
+// with exponential backoff and jitter, so after a crash the outbox is simply
+// drained again. Rows handed to a sink that holds them (an email digest) stay
+// until the sink reports them sent.
+class NotificationOutbox {
+public:
+    using FailureHandler = std::function<void(const OutboxEntry& entry, const std::string& error)>;
+
+    explicit NotificationOutbox(std::shared_ptr<Database> database);
+    ~NotificationOutbox();
+
+    NotificationOutbox(const NotificationOutbox&) = delete;
+    NotificationOutbox& operator=(const NotificationOutbox&) = delete;
+
+    // Channel registration (registering an existing channel replaces its sink)
+    bool registerChannel(const std::string& channel, std::shared_ptr<Notification> sink);
+    bool unregisterChannel(const std::string& channel);
+
+    // Persist a notification for delivery, first attempted at notBefore (now
+    // by default); false if it could not be written. Due entries are
+    // delivered most urgent priority first.
+    bool enqueue(const std::string& channel, const Task& task, const std::string& message,
+                 NotificationPriority priority = NotificationPriority::Normal,
+                 std::chrono::system_clock::time_point notBefore = {});
+
+    // Deliver every due entry once; returns the number delivered
+    size_t drain();
+
+    void start();
+    // Stops after the channel being delivered; undelivered rows stay due
+    // for the next session
+    void stop();
+
+    bool setRetryPolicy(const std::chrono::milliseconds& baseDelay, const std::chrono::milliseconds& maxDelay);
+    bool setPollInterval(const std::chrono::milliseconds& interval);
+    void setFailureHandler(FailureHandler handler);
+
+    size_t getPendingCount();
+    size_t getPendingCount(NotificationPriority priority);
+    std::chrono::milliseconds getBaseDelay() const;
+    std::chrono::milliseconds getMaxDelay() const;
+
+private:
+    std::shared_ptr<Database> db;
+    std::map<std::string, std::shared_ptr<Notification>> channels;
+    FailureHandler onFailure;
+
+    std::chrono::milliseconds baseDelay{1000};
+    std::chrono::milliseconds maxDelay{15 * 60 * 1000};
+    std::chrono::milliseconds pollInterval{1000};
+    int batchSize{100};
+
+    // dbMutex serialises use of the connection and guards storeFailures;
+    // stateMutex guards the rest
+    std::mutex drainMutex;
+    std::mutex dbMutex;
+    size_t storeFailures{0};  // rows left due by a failed delete or reschedule
+    mutable std::mutex stateMutex;
+    std::condition_variable wakeup;
+    std::thread worker;
+    bool running{false};
+    bool stopping{false};
+    bool pendingWork{false};
+    std::mt19937 jitterEngine{std::random_device{}()};
+
+    void runWorker();
+    bool isStopping() const;
+    size_t deliverBatch(const std::vector<OutboxEntry>& entries);
+    size_t deliverChannel(const std::string& channel, const std::vector<const OutboxEntry*>& entries);
+    bool finishEntry(const OutboxEntry& entry, const std::string& error,
+                     std::chrono::steady_clock::time_point retryAt, std::chrono::milliseconds holdTime,
+                     const FailureHandler& failureHandler);
+    void acknowledge(const std::vector<NotificationRequest>& delivered);
+    void deferEntry(const OutboxEntry& entry, std::chrono::steady_clock::time_point retryAt);
+    std::chrono::milliseconds nextBackoff(int attempts);
+};
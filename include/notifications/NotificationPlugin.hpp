@@ -0,0 +1,36 @@
+#pragma once
+#include "Notification.hpp"
+
+// Interface between the application and a notification sink plugin. A
+// plugin is a shared object built against these headers (-fPIC -shared)
+// that exports the three functions below with C linkage; it resolves the
+// Notification base class from the application, which is linked with
+// -rdynamic. The ABI version changes whenever Notification's layout does.
+constexpr int NotificationPluginAbiVersion = 1;
+
+extern "C" {
+    // Returns NotificationPluginAbiVersion as the plugin was built
+    using NotificationPluginAbiFunction = int (*)();
+    // Creates a sink from the text given to 'plugin load'; null or throwing on error
+    using CreateNotificationSinkFunction = Notification* (*)(const char* config);
+    // Destroys a sink made by the same plugin
+    using DestroyNotificationSinkFunction = void (*)(Notification* sink);
+}
+
+// Defines the exported functions for a sink class constructible from the
+// config string, e.g. NOTIFICATION_PLUGIN(MySink) in the plugin's source
+#define NOTIFICATION_PLUGIN(SinkClass)                                       \
+    extern "C" int notificationPluginAbi() {                                 \
+        return NotificationPluginAbiVersion;                                 \
+    }                                                                        \
+    extern "C" Notification* createNotificationSink(const char* config) {    \
+        return new SinkClass(std::string(config ? config : ""));             \
+    }                                                                        \
+    extern "C" void destroyNotificationSink(Notification* sink) {            \
+        delete sink;                                                         \
+    }
+
+// Names the loader looks up
+#define NOTIFICATION_PLUGIN_ABI_SYMBOL "notificationPluginAbi"
+#define NOTIFICATION_PLUGIN_CREATE_SYMBOL "createNotificationSink"
+#define NOTIFICATION_PLUGIN_DESTROY_SYMBOL "destroyNotificationSink"
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "NotificationPlugin.hpp"
+
+// Loads notification sinks from plugin shared objects (see
+// NotificationPlugin.hpp). A library stays loaded until the last sink it
+// created is destroyed.
+class PluginLoader {
+public:
+    struct LoadedPlugin {
+        std::string path;
+        std::string channel;
+        std::shared_ptr<Notification> sink;
+    };
+
+    // Opens the library and creates a sink from config; throws
+    // NotificationException if the library, its exports or the sink are invalid
+    std::shared_ptr<Notification> load(const std::string& path, const std::string& channel,
+                                       const std::string& config);
+    // Forgets the plugin bound to channel; false if there is none
+    bool unload(const std::string& channel);
+
+    bool isPluginChannel(const std::string& channel) const;
+    std::vector<LoadedPlugin> getPlugins() const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<LoadedPlugin> plugins;
+};
\ No newline at end of file
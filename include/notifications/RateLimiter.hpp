@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Token bucket implemented as GCRA: the only state is the theoretical arrival
+// time of the next request, advanced with a compare-and-swap, so checking the
+// limit never takes a lock. A default-constructed limiter admits everything.
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RateLimiter() = default;
+    RateLimiter(double perSecond, size_t burst);
+
+    // perSecond must be positive and burst at least 1
+    bool setRate(double perSecond, size_t burst);
+    void disable() noexcept;
+    bool isEnabled() const noexcept;
+
+    // Take cost tokens. When over the limit nothing is taken, false is
+    // returned and retryAt (if given) is when the same request would pass.
+    // A request larger than the burst passes only against a full bucket.
+    bool tryAcquire(size_t cost = 1, Clock::time_point* retryAt = nullptr) noexcept;
+    // Return tokens taken for a request that was not sent after all
+    void release(size_t cost = 1) noexcept;
+
+    double getRate() const noexcept;
+    size_t getBurst() const noexcept;
+    size_t getLimitedCount() const noexcept;
+
+private:
+    // Nanoseconds per token (0 = unlimited) and the burst expressed as time
+    std::atomic<std::int64_t> emissionInterval{0};
+    std::atomic<std::int64_t> burstWindow{0};
+    // Nanoseconds on Clock; the bucket is full whenever this is in the past
+    std::atomic<std::int64_t> theoreticalArrival{0};
+    std::atomic<size_t> limited{0};
+};
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+#include "Notification.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Pushes fired reminders to local subscribers connected to a Unix domain
+// socket. Every reminder is encoded once as a length-prefixed binary frame and
+// copied into each subscriber's ring buffer; an event loop thread drains the
+// buffers with non-blocking writes, so a stuck subscriber only fills its own
+// buffer and is then dropped from or disconnected according to the policy.
+//
+// Frame layout, integers big-endian:
+//   u32 length of the rest of the frame
+//   u8  frame type (1 = reminder)
+//   i64 fired time, ms since epoch
+//   i32 task id
+//   i64 due date, ms since epoch
+//   i32 reminder minutes
+//   u32 description length, description bytes (UTF-8)
+//   u32 message length, message bytes (UTF-8)
+//   u32 idempotency key length, key bytes (ASCII)
+class SocketNotification : public Notification {
+public:
+    // What happens to a frame that does not fit in a subscriber's buffer
+    enum class SlowSubscriberPolicy {
+        DropFrame,
+        Disconnect
+    };
+
+    static constexpr std::uint8_t ReminderFrame = 1;
+
+    // Not available on Windows; the constructor throws NotificationException
+    explicit SocketNotification(std::string socketPath);
+    ~SocketNotification() override;
+
+    SocketNotification(const SocketNotification&) = delete;
+    SocketNotification& operator=(const SocketNotification&) = delete;
+
+    void sendNotification(const Task& task, const std::string& message) override;
+    void sendNotificationBatch(const std::vector<NotificationRequest>& batch) override;
+
+    bool setBufferSize(size_t bytes);
+    void setSlowSubscriberPolicy(SlowSubscriberPolicy policy);
+    bool setMaxSubscribers(size_t count);
+
+    std::string getPath() const;
+    size_t getBufferSize() const;
+    SlowSubscriberPolicy getSlowSubscriberPolicy() const;
+    size_t getMaxSubscribers() const;
+    size_t getSubscriberCount() const;
+    size_t getDroppedFrames() const;
+    size_t getDisconnectedCount() const;
+
+    static const char* policyName(SlowSubscriberPolicy policy);
+
+private:
+    // Fixed-size byte ring; frames are only ever added whole
+    struct Subscriber {
+        int fd{-1};
+        std::vector<char> ring;
+        size_t head{0};
+        size_t used{0};
+        size_t dropped{0};
+        bool closing{false};
+    };
+
+    std::string path;
+    int listenFd{-1};
+    int wakeFds[2]{-1, -1};
+
+    size_t bufferSize{256 * 1024};
+    SlowSubscriberPolicy policy{SlowSubscriberPolicy::DropFrame};
+    size_t maxSubscribers{64};
+
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    size_t droppedFrames{0};
+    size_t disconnected{0};
+    std::string frame;
+
+    mutable std::mutex mutex;
+    std::thread loopThread;
+    bool stopping{false};
+
+    void openListener();
+    void closeListener();
+    void wakeEventLoop();
+    void runEventLoop();
+    void acceptSubscribers();
+    bool flushSubscriber(Subscriber& subscriber);
+    void closeSubscriber(Subscriber& subscriber);
+    void encodeFrame(const Task& task, const std::string& message);
+    void enqueueFrame();
+};
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+#include "Notification.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef void CURL;
+typedef void CURLM;
+struct curl_slist;
+
+// POSTs each reminder as JSON to a URL. Requests are queued and driven by one
+// event loop thread over the libcurl multi interface, so many requests can be
+// in flight at once over pooled keep-alive connections. sendNotification only
+// enqueues; each request's result is counted in the statistics and reported
+// through reportOutcome, so failures reach the circuit breaker and the
+// dispatcher's failure handler.
+class WebhookNotification : public Notification {
+public:
+    struct Stats {
+        size_t delivered{0};
+        size_t failed{0};
+        size_t inFlight{0};
+        size_t queued{0};
+        double averageLatencyMs{0.0};
+        double maxLatencyMs{0.0};
+        double requestsPerSecond{0.0};
+    };
+
+    explicit WebhookNotification(std::string url);
+    ~WebhookNotification() override;
+
+    WebhookNotification(const WebhookNotification&) = delete;
+    WebhookNotification& operator=(const WebhookNotification&) = delete;
+
+    // Throws NotificationException when the queue is full
+    void sendNotification(const Task& task, const std::string& message) override;
+    bool reportsOutcomes() const override;
+
+    bool setUrl(const std::string& newUrl);
+    bool setTimeout(const std::chrono::milliseconds& timeout);
+    bool setMaxInFlight(size_t maxRequests);
+    bool setMaxQueued(size_t maxRequests);
+
+    std::string getUrl() const;
+    std::chrono::milliseconds getTimeout() const;
+    size_t getMaxInFlight() const;
+    size_t getMaxQueued() const;
+
+    Stats getStats() const;
+    void resetStats();
+    // Block until nothing is queued or in flight; false on timeout
+    bool waitUntilIdle(const std::chrono::milliseconds& timeout);
+
+private:
+    struct Payload {
+        std::string idempotencyKey;
+        std::string body;
+        Task task;
+        std::string message;
+    };
+
+    struct Request {
+        CURL* handle{nullptr};
+        std::string body;
+        curl_slist* headers{nullptr};
+        std::chrono::steady_clock::time_point started;
+        Task task;
+        std::string message;
+    };
+
+    std::string url;
+    std::chrono::milliseconds timeout{5000};
+    size_t maxInFlight{32};
+    size_t maxQueued{10000};
+    // The multi handle is only touched by the loop thread, which applies this
+    bool connectionLimitChanged{false};
+
+    CURLM* multi{nullptr};
+    std::deque<Payload> queue;
+    std::vector<Request*> active;
+    std::vector<CURL*> idleHandles;
+
+    size_t delivered{0};
+    size_t failed{0};
+    std::chrono::steady_clock::duration totalLatency{};
+    std::chrono::steady_clock::duration maxLatency{};
+    std::chrono::steady_clock::time_point firstRequest{};
+    std::chrono::steady_clock::time_point lastCompletion{};
+
+    mutable std::mutex mutex;
+    std::condition_variable idle;
+    std::thread loopThread;
+    bool stopping{false};
+
+    void runEventLoop();
+    bool startRequest(Payload& payload);
+    void finishRequest(CURL* handle, int result);
+    std::string buildPayload(const Task& task, const std::string& message) const;
+};
\ No newline at end of file
@@ -0,0 +1,42 @@
+// Example notification sink plugin: appends one line per notification to the
+// file named in its config (standard error when none is given).
+//
+//   make plugins
+//   plugin load ./plugins/line_sink.so lines /tmp/reminders.txt
+//   schedule 1 console,lines
+#include "notifications/NotificationPlugin.hpp"
+#include "database/Exceptions.hpp"
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+class LineSink : public Notification {
+public:
+    explicit LineSink(const std::string& path) {
+        if (!path.empty()) {
+            file.open(path, std::ios::app);
+            if (!file) {
+                throw NotificationException("Cannot open " + path);
+            }
+        }
+    }
+
+    void sendNotification(const Task& task, const std::string& message) override {
+        std::string line;
+        appendIsoTimestamp(line, std::chrono::system_clock::now());
+        line += " task #" + std::to_string(task.getId()) + " " + task.getDescription() + ": " + message + "\n";
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ostream& out = file.is_open() ? static_cast<std::ostream&>(file) : std::cerr;
+        out << line << std::flush;
+        if (!out) {
+            throw NotificationException("Failed to write notification line");
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::ofstream file;
+};
+
+NOTIFICATION_PLUGIN(LineSink)
\ No newline at end of file
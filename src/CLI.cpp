@@ -1,5 +1,6 @@
 #include "../include/core/CLI.hpp"
 #include <sstream>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <memory>
@@ -7,34 +8,189 @@
 #include <iomanip>
 #include <map>
 #include <algorithm>
-#include <regex>
-#include <thread>
-#include <atomic>
 
 // Global variables for application state
 std::shared_ptr<Database> db;
 std::shared_ptr<Scheduler> scheduler;
 std::shared_ptr<ConsoleNotification> consoleNotifier;
 std::shared_ptr<EmailNotification> emailNotifier;
-std::atomic<bool> stopChecker{false};
-std::thread checkerThread;
+std::shared_ptr<FileNotification> fileNotifier;
+std::shared_ptr<WebhookNotification> webhookNotifier;
+std::shared_ptr<SocketNotification> socketNotifier;
+std::shared_ptr<NotificationDispatcher> dispatcher;
+std::shared_ptr<NotificationOutbox> outbox;
+std::shared_ptr<FireLedger> fireLedger;
+std::shared_ptr<ChannelRegistry> channelRegistry;
+std::shared_ptr<PluginLoader> pluginLoader;
+std::shared_ptr<DeferredDelivery> deferredDelivery;
+std::shared_ptr<EventChecker> eventChecker;
 bool running = true;
+CommandStatus commandStatus;
 
-void runEventChecker(std::shared_ptr<Scheduler> scheduler) {
-    while (!stopChecker) {
-        try {
-            // Check for events every 15 seconds
-            auto result = scheduler->checkAndTriggerEvents();
-            if (result && result.value()) {
-                // Events were triggered, no need to print anything here
-                // Console notifications will be displayed by the callback
+// How long notifications still queued at shutdown get to go out
+constexpr std::chrono::milliseconds ShutdownDrainTimeout{2000};
+
+bool startServices(const std::string& dbPath, bool quiet) {
+    db = std::make_shared<Database>(dbPath);
+    auto initResult = db->initializeDatabase();
+    if (!initResult) {
+        TaskApp::handleError(initResult.error());
+        return false;
+    }
+    
+    scheduler = std::make_shared<Scheduler>();
+    scheduler->setDefaultReminderMessage("Task reminder: Don't forget about your task!");
+    eventChecker = std::make_shared<EventChecker>(scheduler);
+    
+    consoleNotifier = std::make_shared<ConsoleNotification>();
+    consoleNotifier->setNotificationPrefix("[TASK]");
+    consoleNotifier->setColorOutput(true);
+    consoleNotifier->setVerboseOutput(true);
+    consoleNotifier->setNotificationSound(true);
+    consoleNotifier->setStandardError(quiet);
+
+    // Notifications are delivered on per-sink threads; the checker only enqueues
+    dispatcher = std::make_shared<NotificationDispatcher>();
+    dispatcher->addSink(consoleNotifier);
+
+    // Built-in channels exist from the start and get sinks once configured;
+    // plugins add more. Email is delivered through the outbox.
+    channelRegistry = std::make_shared<ChannelRegistry>();
+    channelRegistry->bind("console", consoleNotifier);
+    channelRegistry->add("email", true);
+    channelRegistry->add("file");
+    channelRegistry->add("webhook");
+    channelRegistry->add("socket");
+    pluginLoader = std::make_shared<PluginLoader>();
+
+    // Reminders held by a closed delivery window are released through here
+    deferredDelivery = std::make_shared<DeferredDelivery>(scheduler,
+        [](const ChannelRegistry::Channel& channel, const NotificationRequest& request) {
+            if (channel.getSink()) {
+                return submitToChannel(channel, request.task, request.message, request.priority, request.receipt);
             }
-        } catch (const std::exception& e) {
-            std::cerr << "Error in background checker: " << e.what() << std::endl;
+            // Unconfigured while the reminder was held
+            std::cerr << "Notification via " << channel.getName() << " unavailable, using console" << std::endl;
+            showOnConsole(request.task, request.message, request.priority, request.receipt);
+            return true;
+        });
+
+    // Email goes through the durable outbox on its own connection; entries
+    // left by a previous session are delivered once email is configured
+    outbox = std::make_shared<NotificationOutbox>(std::make_shared<Database>(dbPath));
+    outbox->setFailureHandler([](const OutboxEntry& entry, const std::string& error) {
+        std::cerr << "Notification via " << entry.channel << " failed (attempt " << entry.attempts
+                  << "), will retry: " << error << std::endl;
+        // Show the reminder on the console the first time so it is not missed
+        if (entry.attempts == 1) {
+            showOnConsole(entry.task, entry.message);
         }
-        
-        // Sleep for a short interval before checking again
-        std::this_thread::sleep_for(std::chrono::seconds(15));
+    });
+    outbox->start();
+    
+    if (!quiet) {
+        std::cout << "Console notifications enabled and ready" << std::endl;
+    }
+
+    // Fires are written to the ledger in batches on its own connection, each
+    // once the reminder has been delivered (see makeNotificationCallback)
+    fireLedger = std::make_shared<FireLedger>(std::make_shared<Database>(dbPath));
+    fireLedger->start();
+    size_t restored = restoreScheduledNotifications();
+    if (!quiet && restored > 0) {
+        std::cout << "Restored " << restored << " scheduled reminders" << std::endl;
+    }
+    return true;
+}
+
+void startEventChecker() {
+    if (eventChecker) {
+        eventChecker->start();
+    }
+}
+
+void stopServices() {
+    // Nothing fires once the checker is stopped, so what follows drains a
+    // fixed amount of work
+    if (eventChecker) {
+        eventChecker->stop();
+    }
+    // Held reminders were never recorded as fired, so they are re-armed and
+    // held again next session
+    if (deferredDelivery) {
+        size_t held = deferredDelivery->abandon();
+        if (held > 0) {
+            std::cerr << held << " reminders held for a delivery window will be re-armed on restart" << std::endl;
+        }
+    }
+    auto deadline = std::chrono::steady_clock::now() + ShutdownDrainTimeout;
+
+    if (db && db->inTransaction()) {
+        db->commitTransaction();
+    }
+    if (outbox) {
+        outbox->stop();
+    }
+    if (dispatcher) {
+        dispatcher->shutdown(deadline);
+    }
+    // Last, so fires completed by the deliveries above are written too
+    if (fireLedger) {
+        fireLedger->stop();
+    }
+}
+
+std::map<std::string, CommandHandler> makeCommandMap() {
+    return {
+        {"help", [](const std::vector<std::string>&) { printHelp(); }},
+        {"add", handleAddTask},
+        {"list", handleListTasks},
+        {"update", handleUpdateTask},
+        {"delete", handleDeleteTask},
+        {"complete", handleCompleteTask},
+        {"schedule", handleScheduleTask},
+        {"check", handleCheckEvents},
+        {"email", handleEmailSetup},
+        {"digest", handleDigestSetup},
+        {"recipients", handleRecipients},
+        {"outbox", handleOutbox},
+        {"filelog", handleFileLogSetup},
+        {"webhook", handleWebhookSetup},
+        {"socket", handleSocketSetup},
+        {"breaker", handleBreaker},
+        {"notifystats", handleNotifyStats},
+        {"lanes", handleLanes},
+        {"plugin", handlePlugin},
+        {"window", handleWindow},
+        {"ratelimit", handleRateLimit},
+        {"template", handleTemplate},
+        {"test", handleTestNotification},
+        {"exit", handleExit},
+        {"quit", handleExit},
+    };
+}
+
+// Runs one parsed command line; errors are reported and flagged in commandStatus
+static void executeCommand(const std::map<std::string, CommandHandler>& commandMap,
+                           const std::vector<std::string>& args) {
+    commandStatus = CommandStatus{};
+
+    auto it = commandMap.find(args[0]);
+    if (it == commandMap.end()) {
+        commandStatus.failed = true;
+        std::cout << "Unknown command: " << args[0] << std::endl;
+        std::cout << "Type 'help' for available commands." << std::endl;
+        return;
+    }
+
+    try {
+        it->second(args);
+    } catch (const TaskAppException& e) {
+        commandStatus.failed = true;
+        std::cerr << "Error: " << e.what() << std::endl;
+    } catch (const std::exception& e) {
+        commandStatus.failed = true;
+        std::cerr << "Unexpected error: " << e.what() << std::endl;
     }
 }
 
@@ -46,44 +202,17 @@ void runCLI(const std::string& dbPath) {
         std::cout << "================" << std::endl;
         std::cout << "Initializing with database: " << dbPath << std::endl;
         
-        db = std::make_shared<Database>(dbPath);
-        auto initResult = db->initializeDatabase();
-        if (!initResult) {
-            TaskApp::handleError(initResult.error());
+        if (!startServices(dbPath, false)) {
             return;
         }
-        
-        scheduler = std::make_shared<Scheduler>();
-        scheduler->setDefaultReminderMessage("Task reminder: Don't forget about your task!");
-        
-        consoleNotifier = std::make_shared<ConsoleNotification>();
-        consoleNotifier->setNotificationPrefix("[TASK]");
-        consoleNotifier->setColorOutput(true);
-        consoleNotifier->setVerboseOutput(true);
-        consoleNotifier->setNotificationSound(true);
-        
-        std::cout << "Console notifications enabled and ready" << std::endl;
 
         // Start the automatic event checker thread
-        stopChecker = false;
-        checkerThread = std::thread(runEventChecker, scheduler);
-        std::cout << "Automatic notification checking enabled (15-second intervals)" << std::endl;
-        
-        
-        // Map of commands to their handlers
-        std::map<std::string, CommandHandler> commandMap = {
-            {"help", [](const std::vector<std::string>&) { printHelp(); }},
-            {"add", handleAddTask},
-            {"list", handleListTasks},
-            {"update", handleUpdateTask},
-            {"delete", handleDeleteTask},
-            {"complete", handleCompleteTask},
-            {"schedule", handleScheduleTask},
-            {"check", handleCheckEvents},
-            {"email", handleEmailSetup},
-            {"exit", handleExit},
-            {"quit", handleExit},
-        };
+        startEventChecker();
+        std::cout << "Automatic notification checking enabled ("
+                  << std::chrono::duration_cast<std::chrono::seconds>(eventChecker->getInterval()).count()
+                  << "-second intervals)" << std::endl;
+        
+        auto commandMap = makeCommandMap();
         
         printHelp();
         
@@ -92,7 +221,11 @@ void runCLI(const std::string& dbPath) {
             std::string input;
             std::cout << "\n> ";
             std::cout.flush(); 
-            std::getline(std::cin, input);
+            // End of input leaves like exit
+            if (!std::getline(std::cin, input)) {
+                std::cout << std::endl;
+                break;
+            }
             
             if (input.empty()) {
                 continue;
@@ -103,63 +236,215 @@ void runCLI(const std::string& dbPath) {
                 continue;
             }
             
-            std::string command = args[0];
-            
-            auto it = commandMap.find(command);
-            if (it != commandMap.end()) {
-                try {
-                    it->second(args);
-                } catch (const TaskAppException& e) {
-                    std::cerr << "Error: " << e.what() << std::endl;
-                } catch (const std::exception& e) {
-                    std::cerr << "Unexpected error: " << e.what() << std::endl;
-                }
-            } else {
-                std::cout << "Unknown command: " << command << std::endl;
-                std::cout << "Type 'help' for available commands." << std::endl;
-            }
+            executeCommand(commandMap, args);
         }
 
-        // Clean up the checker thread when exiting
-        stopChecker = true;
-        if (checkerThread.joinable()) {
-            checkerThread.join();
-        }
+        stopServices();
         
     } catch (const ConnectionException& e) {
         // Clean up thread if an exception occurs
-        stopChecker = true;
-        if (checkerThread.joinable()) {
-            checkerThread.join();
-        }
+        stopServices();
         std::cerr << "Database connection error: " << e.what() << std::endl;
     } catch (const DatabaseException& e) {
+        stopServices();
         std::cerr << "Database error: " << e.what() << std::endl;
     } catch (const std::exception& e) {
+        stopServices();
         std::cerr << "Unexpected error: " << e.what() << std::endl;
     }
     
 }
 
+namespace {
+    // Consecutive commands from this set share one transaction. Only
+    // database writes belong here: a rolled back group must leave nothing
+    // else behind, which is why schedule (it arms the scheduler) is not one
+    bool isMutatingCommand(const std::string& command) {
+        return command == "add" || command == "update" || command == "delete" ||
+               command == "complete";
+    }
+
+    // Longest run of commands in one transaction, and longest it stays open,
+    // so the fire ledger and outbox connections never wait on a batch past
+    // their busy timeout
+    constexpr size_t BatchTransactionLimit = 1000;
+    constexpr std::chrono::milliseconds BatchTransactionWindow{250};
+}
+
+CommandBatch::CommandBatch(std::map<std::string, CommandHandler> commands, Writer writer)
+    : commandMap(std::move(commands)), write(std::move(writer)) {}
+
+CommandBatch::~CommandBatch() {
+    flush();
+}
+
+bool CommandBatch::run(int client, size_t line, const std::string& text) {
+    auto args = parseArguments(text);
+    if (args.empty() || args[0].front() == '#') {
+        return false;
+    }
+
+    bool mutating = isMutatingCommand(args[0]);
+    if (!mutating || pending.size() >= BatchTransactionLimit ||
+        std::chrono::steady_clock::now() - groupStarted >= BatchTransactionWindow) {
+        flush();
+    }
+    // Without a transaction (database busy) each write commits on its own
+    if (mutating && !db->inTransaction()) {
+        db->beginTransaction();
+        groupStarted = std::chrono::steady_clock::now();
+    }
+
+    // Handlers print to std::cout; their text is captured for the result
+    captured.str(std::string());
+    std::streambuf* stdoutBuffer = std::cout.rdbuf(captured.rdbuf());
+    executeCommand(commandMap, args);
+    std::cout.rdbuf(stdoutBuffer);
+
+    pending.push_back({client, line, args[0], commandStatus, captured.str()});
+    if (!mutating) {
+        flush();
+    }
+    return true;
+}
+
+void CommandBatch::flush() {
+    std::string error;
+    if (db && db->inTransaction()) {
+        auto commitResult = db->commitTransaction();
+        if (!commitResult) {
+            error = "transaction rolled back: " + commitResult.error().message();
+        }
+    }
+
+    std::string result;
+    for (const auto& entry : pending) {
+        bool ok = !entry.status.failed && error.empty();
+        if (!ok) {
+            ++failures;
+        }
+
+        result.clear();
+        result += "{\"line\":";
+        result += std::to_string(entry.line);
+        result += ",\"command\":";
+        Notification::appendJsonString(result, entry.command);
+        result += ok ? ",\"ok\":true" : ",\"ok\":false";
+        if (entry.status.taskId > 0) {
+            result += ",\"id\":";
+            result += std::to_string(entry.status.taskId);
+        }
+        if (!error.empty()) {
+            result += ",\"error\":";
+            Notification::appendJsonString(result, error);
+        }
+        result += ",\"output\":";
+        std::string_view text = entry.output;
+        while (!text.empty() && text.back() == '\n') {
+            text.remove_suffix(1);
+        }
+        Notification::appendJsonString(result, text);
+        result += "}\n";
+        write(entry.client, result);
+    }
+    pending.clear();
+}
+
+size_t CommandBatch::getFailureCount() const {
+    return failures;
+}
+
+int runBatch(const std::string& dbPath, const std::string& source) {
+    std::ifstream file;
+    if (source != "-") {
+        file.open(source);
+        if (!file) {
+            std::cerr << "Cannot open batch file: " << source << std::endl;
+            return 2;
+        }
+    }
+    std::istream& input = source == "-" ? std::cin : file;
+
+    size_t failures = 0;
+    try {
+        if (!startServices(dbPath, true)) {
+            stopServices();
+            return 1;
+        }
+
+        // Results are buffered and written to stdout once per transaction
+        std::string results;
+        {
+            CommandBatch batch(makeCommandMap(), [&results](int, const std::string& result) {
+                results += result;
+            });
+
+            std::string line;
+            size_t lineNumber = 0;
+            while (running && std::getline(input, line)) {
+                batch.run(0, ++lineNumber, line);
+                if (!results.empty()) {
+                    std::cout << results;
+                    std::cout.flush();
+                    results.clear();
+                }
+            }
+            batch.flush();
+            failures = batch.getFailureCount();
+        }
+        std::cout << results;
+        std::cout.flush();
+
+        stopServices();
+
+    } catch (const DatabaseException& e) {
+        stopServices();
+        std::cerr << "Database error: " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        stopServices();
+        std::cerr << "Unexpected error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
+
 // Print help information
 void printHelp() {
     std::cout << "\nAvailable commands:\n";
     std::cout << "  help                             - Show this help message\n";
     std::cout << "  add <description> <due_date> <reminder_minutes>  - Add a new task\n";
-    std::cout << "  list [pending|all]               - List tasks\n";
+    std::cout << "  list [pending|all] [--format table|csv|json] - List tasks\n";
     std::cout << "  update <id> <description> <due_date> <reminder_minutes> - Update a task\n";
     std::cout << "  delete <id>                      - Delete a task\n";
     std::cout << "  complete <id>                    - Mark a task as completed\n";
-    std::cout << "  schedule <id> <notification_type> - Schedule a task for notification\n";
+    std::cout << "  schedule <id> <type[,type...]> [high|normal|low] - Schedule a task for notification on one or more channels\n";
     std::cout << "  check                            - Check and trigger due events\n";
-    std::cout << "  email <recipient> <smtp_server> <port> - Configure email notification\n";
+    std::cout << "  email <recipient[,recipient...]> <smtp_server> <port> - Configure email notification\n";
+    std::cout << "  recipients [add|remove <address>] - Show or change email recipients\n";
+    std::cout << "  digest <window_minutes> <max_reminders>|off - Batch email reminders into digests\n";
+    std::cout << "  filelog <path> [max_size_mb] [max_files] - Record notifications in a rotating log\n";
+    std::cout << "  webhook <url> [timeout_ms] [max_in_flight] - POST notifications as JSON to a URL\n";
+    std::cout << "  socket [<path> [buffer_kb] [drop|disconnect]] - Stream notifications to local subscribers\n";
+    std::cout << "  outbox [drain]                   - Show or deliver pending outbox notifications\n";
+    std::cout << "  breaker <channel> [threshold open_seconds] - Show or configure a circuit breaker\n";
+    std::cout << "  ratelimit <channel|recipient> [<per_second> [burst]|off] - Show or set a rate limit\n";
+    std::cout << "  notifystats [channel|reset]      - Show delivery counts, latencies and queue ages\n";
+    std::cout << "  lanes [strict|weighted [high normal low]] - Show or set how priority lanes are drained\n";
+    std::cout << "  template <console|email> [subject|body <text>|default] - Show or set notification templates\n";
+    std::cout << "  window [<channel> <HH:MM-HH:MM|off>|release <per_second>] - Show or set delivery windows\n";
+    std::cout << "  plugin [list|load <path> <channel> [config]|unload <channel>] - Manage notification sink plugins\n";
+    std::cout << "  test <channel> [count]           - Send test notifications and report throughput\n";
     std::cout << "  exit|quit                        - Exit the application\n";
-    std::cout << "\nDate format: YYYY-MM-DD HH:MM or +minutes (for relative time from now)\n";
+    std::cout << "\nDate format: YYYY-MM-DD HH:MM[:SS] or ISO 8601 (2025-04-10T15:00+02:00),\n";
+    std::cout << "             +minutes or +2h, +3d, +1h30m (from now), or today|tomorrow|<weekday> [HH:MM]\n";
 }
 
 namespace TaskApp
 {
     void handleError(const std::error_code& error) {
+        commandStatus.failed = true;
         std::cerr << "Error: " << error.message() << " (code: " << error.value() << ")" << std::endl;
     }
 } 
@@ -201,91 +486,36 @@ std::string trimString(const std::string& str) {
 
 // Parse date time string in format YYYY-MM-DD HH:MM or +minutes
 std::chrono::system_clock::time_point parseDateTime(const std::string& dateTimeStr) {
-    // Check for relative time format (+minutes)
-    static const std::regex relative_re(R"(\+(\d+))");
-    std::smatch match;
-    if (std::regex_match(dateTimeStr, match, relative_re)) {
-        try {
-            int minutes = std::stoi(match[1]);
-            if (minutes < 0) {
-                throw std::invalid_argument("Relative time cannot be negative");
-            }
-            return std::chrono::system_clock::now() + std::chrono::minutes(minutes);
-        } catch (const std::exception&) {
-            throw std::invalid_argument("Invalid relative time format. Use +minutes");
-        }
-    }
-
-    // Parse absolute date/time (YYYY-MM-DD HH:MM)
-    std::tm tm = {};
-    std::istringstream ss(dateTimeStr);
-    char date_delim1, date_delim2, time_delim;
-    int year, month, day, hour, minute;
-
-    // Parse date and time components
-    ss >> year >> date_delim1 >> month >> date_delim2 >> day >> hour >> time_delim >> minute;
-
-    if (ss.fail() || date_delim1 != '-' || date_delim2 != '-' || time_delim != ':') {
-        throw std::invalid_argument("Invalid date/time format. Use YYYY-MM-DD HH:MM or +minutes");
+    auto now = std::chrono::system_clock::now();
+    std::chrono::system_clock::time_point time;
+    const char* error = nullptr;
+    if (!TimeFormat::parse(dateTimeStr, now, time, &error)) {
+        throw std::invalid_argument(std::string(error) +
+                                    ". Use YYYY-MM-DD HH:MM[:SS], ISO 8601, +minutes, +2h, +3d or a weekday");
     }
 
     // Validate ranges
-    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    std::tm now_tm = *std::localtime(&now);
-    int current_year = now_tm.tm_year + 1900;
-
-    if (year < current_year || year > current_year + 10) {
-        throw std::invalid_argument("Year must be between " + std::to_string(current_year) + 
-                                  " and " + std::to_string(current_year + 10));
-    }
-    if (month < 1 || month > 12) {
-        throw std::invalid_argument("Month must be between 1 and 12");
-    }
-    if (day < 1 || day > 31) {
-        throw std::invalid_argument("Day must be between 1 and 31");
-    }
-    if (hour < 0 || hour > 23) {
-        throw std::invalid_argument("Hour must be between 0 and 23");
-    }
-    if (minute < 0 || minute > 59) {
-        throw std::invalid_argument("Minute must be between 0 and 59");
-    }
-
-    // Set tm struct
-    tm.tm_year = year - 1900;
-    tm.tm_mon = month - 1;
-    tm.tm_mday = day;
-    tm.tm_hour = hour;
-    tm.tm_min = minute;
-    tm.tm_sec = 0;
-    tm.tm_isdst = -1; // Let mktime determine daylight saving time
-
-    // Convert to time_t and validate
-    auto time = std::mktime(&tm);
-    if (time == -1) {
-        throw std::invalid_argument("Invalid date/time combination");
+    long long currentYear = TimeFormat::localYear(now);
+    long long year = TimeFormat::localYear(time);
+    if (year > currentYear + 10) {
+        throw std::invalid_argument("Year must be between " + std::to_string(currentYear) +
+                                  " and " + std::to_string(currentYear + 10));
     }
 
     // Check if the date is in the past
-    if (std::chrono::system_clock::from_time_t(time) < std::chrono::system_clock::now()) {
+    if (time < now) {
         throw std::invalid_argument("Date/time cannot be in the past");
     }
 
-    return std::chrono::system_clock::from_time_t(time);
+    return time;
 }
 
 namespace TaskApp {
 void printTask(const Task& task) {
     std::cout << "Task #" << task.getId() << ": " << task.getDescription() << std::endl;
     
-    auto dueTime = std::chrono::system_clock::to_time_t(task.getDueDate());
-    auto createdTime = std::chrono::system_clock::to_time_t(task.getCreatedAt());
-    
-    std::tm dueTm = *std::localtime(&dueTime);
-    std::tm createdTm = *std::localtime(&createdTime);
-    
-    std::cout << "  Created: " << std::put_time(&createdTm, "%Y-%m-%d %H:%M") << std::endl;
-    std::cout << "  Due: " << std::put_time(&dueTm, "%Y-%m-%d %H:%M") << std::endl;
+    std::cout << "  Created: " << TimeFormat::local(task.getCreatedAt(), false) << std::endl;
+    std::cout << "  Due: " << TimeFormat::local(task.getDueDate(), false) << std::endl;
     std::cout << "  Reminder: " << task.getReminderMinutes() << " minutes before due" << std::endl;
     std::cout << "  Status: " << (task.isCompleted() ? "Completed" : "Pending") << std::endl;
 }
@@ -293,6 +523,7 @@ void printTask(const Task& task) {
 // Handle add task command
 void handleAddTask(const std::vector<std::string>& args) {
     if (args.size() != 4) {  // Changed from 4 to 3 since we want dateTimeStr as one argument
+        commandStatus.failed = true;
         std::cout << "Usage: add \"description\" \"YYYY-MM-DD HH:MM\" reminderMinutes" << std::endl;
         std::cout << "Examples:" << std::endl;
         std::cout << "  add \"Do the dishes\" \"2025-04-05 15:14\" 30" << std::endl;
@@ -316,54 +547,62 @@ void handleAddTask(const std::vector<std::string>& args) {
             return;
         }
         
+        commandStatus.taskId = result.value();
         std::cout << "Task added successfully with ID: " << result.value() << std::endl;
         
     } catch (const InvalidTaskDataException& e) {
+        commandStatus.failed = true;
         std::cout << "Error: Task error: " << e.what() << std::endl;
     } catch (const std::exception& e) {
+        commandStatus.failed = true;
         std::cout << "Error: " << e.what() << std::endl;
     }
 }
 
 // Handle list tasks command
 void handleListTasks(const std::vector<std::string>& args) {
-    std::string type = "all";
-    if (!args.empty()) {
-        type = args[0];
-    }
-    
-    Result<std::vector<Task>> tasksResult;
-    
-    if (type == "pending") {
-        tasksResult = db->getPendingTasks();
-    } else {
-        tasksResult = db->getAllTasks();
-    }
-    
-    if (!tasksResult) {
-        TaskApp::handleError(tasksResult.error());
-        return;
-    }
-    
-    const auto& tasks = tasksResult.value();
-    
-    if (tasks.empty()) {
-        std::cout << "No tasks found." << std::endl;
-        return;
+    bool pendingOnly = false;
+    auto format = TaskWriter::Format::Table;
+
+    for (size_t i = 1; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        if (arg == "pending" || arg == "all") {
+            pendingOnly = arg == "pending";
+        } else if (arg == "--format" && i + 1 < args.size()) {
+            if (!TaskWriter::parseFormat(args[++i], format)) {
+                commandStatus.failed = true;
+                std::cout << "Format must be table, csv or json" << std::endl;
+                return;
+            }
+        } else if (arg.starts_with("--format=")) {
+            if (!TaskWriter::parseFormat(arg.substr(9), format)) {
+                commandStatus.failed = true;
+                std::cout << "Format must be table, csv or json" << std::endl;
+                return;
+            }
+        } else {
+            commandStatus.failed = true;
+            std::cout << "Usage: list [pending|all] [--format table|csv|json]" << std::endl;
+            return;
+        }
     }
-    
-    std::cout << "Found " << tasks.size() << " tasks:" << std::endl;
-    std::cout << "------------------------------" << std::endl;
-    
-    for (const auto& task : tasks) {
-        TaskApp::printTask(task);
-        std::cout << "------------------------------" << std::endl;
+
+    // Rows go straight from the query into the writer's buffer
+    TaskWriter writer(std::cout, format);
+    auto result = db->streamTasks(pendingOnly, [&writer](const TaskRow& row) {
+        writer.write(row);
+    });
+    writer.finish();
+
+    if (!result) {
+        TaskApp::handleError(result.error());
     }
 }
 
 // Handle update task command
 void handleUpdateTask(const std::vector<std::string>& args) {
     if (args.size() <= 1) {  // Show tasks if no ID provided
+        commandStatus.failed = true;
         auto tasksResult = db->getAllTasks();
         if (!tasksResult) {
             TaskApp::handleError(tasksResult.error());
@@ -388,6 +627,7 @@ void handleUpdateTask(const std::vector<std::string>& args) {
     }
 
     if (args.size() != 5) {  // args[0] is "update", so we need 5 total
+        commandStatus.failed = true;
         std::cout << "Usage: update <id> \"description\" \"YYYY-MM-DD HH:MM\" reminderMinutes" << std::endl;
         std::cout << "Example: update 1 \"Do dishes\" \"2025-04-04 22:11\" 10" << std::endl;
         return;
@@ -400,36 +640,37 @@ void handleUpdateTask(const std::vector<std::string>& args) {
         int reminderMinutes = std::stoi(args[4]);
         
         // First get the existing task to preserve creation date
-        auto tasksResult = db->getAllTasks();
-        if (!tasksResult) {
-            TaskApp::handleError(tasksResult.error());
+        auto taskResult = db->getTask(taskId);
+        if (!taskResult) {
+            TaskApp::handleError(taskResult.error());
             return;
         }
         
-        const auto& tasks = tasksResult.value();
-        auto it = std::find_if(tasks.begin(), tasks.end(), 
-                              [taskId](const Task& t) { return t.getId() == taskId; });
-        
-        if (it == tasks.end()) {
+        if (!taskResult.value()) {
+            commandStatus.failed = true;
             std::cout << "Task not found with ID: " << taskId << std::endl;
             return;
         }
         
-        Task task = *it; // Copy the existing task
+        Task task = *taskResult.value(); // Copy the existing task
+        commandStatus.taskId = taskId;
         
         // Update the task properties
         if (!task.setDescription(description)) {
+            commandStatus.failed = true;
             std::cout << "Invalid description" << std::endl;
             return;
         }
         
         auto dueDate = parseDateTime(dateTimeStr);
         if (!task.setDueDate(dueDate)) {
+            commandStatus.failed = true;
             std::cout << "Invalid due date" << std::endl;
             return;
         }
         
         if (!task.setReminderMinutes(reminderMinutes)) {
+            commandStatus.failed = true;
             std::cout << "Invalid reminder time" << std::endl;
             return;
         }
@@ -444,11 +685,14 @@ void handleUpdateTask(const std::vector<std::string>& args) {
             std::cout << "Task updated successfully" << std::endl;
             TaskApp::printTask(task);
         } else {
+            commandStatus.failed = true;
             std::cout << "Task not found or no changes made" << std::endl;
         }
     } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
         std::cout << "Error: Invalid number format for task ID or reminder minutes" << std::endl;
     } catch (const std::exception& e) {
+        commandStatus.failed = true;
         std::cout << "Error: " << e.what() << std::endl;
     }
 }
@@ -456,6 +700,7 @@ void handleUpdateTask(const std::vector<std::string>& args) {
 // Handle delete task command
 void handleDeleteTask(const std::vector<std::string>& args) {
     if (args.size() <= 1) {  // Changed from empty() check to size() <= 1
+        commandStatus.failed = true;
         // First show available tasks
         auto tasksResult = db->getAllTasks();
         if (!tasksResult) {
@@ -483,22 +728,20 @@ void handleDeleteTask(const std::vector<std::string>& args) {
         int taskId = std::stoi(args[1]);  // Changed from args[0] to args[1]
         
         // Get task description before deleting
-        auto tasksResult = db->getAllTasks();
-        if (!tasksResult) {
-            TaskApp::handleError(tasksResult.error());
+        auto taskResult = db->getTask(taskId);
+        if (!taskResult) {
+            TaskApp::handleError(taskResult.error());
             return;
         }
 
-        const auto& tasks = tasksResult.value();
-        auto it = std::find_if(tasks.begin(), tasks.end(), 
-                              [taskId](const Task& t) { return t.getId() == taskId; });
-        
-        if (it == tasks.end()) {
+        if (!taskResult.value()) {
+            commandStatus.failed = true;
             std::cout << "Task not found with ID: " << taskId << std::endl;
             return;
         }
+        commandStatus.taskId = taskId;
 
-        std::string description = it->getDescription();
+        std::string description = taskResult.value()->getDescription();
         
         auto result = db->deleteTask(taskId);
         if (!result) {
@@ -515,11 +758,14 @@ void handleDeleteTask(const std::vector<std::string>& args) {
                 std::cout << "Task notifications cancelled" << std::endl;
             }
         } else {
+            commandStatus.failed = true;
             std::cout << "Task not found" << std::endl;
         }
     } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
         std::cout << "Error: Invalid task ID. Please provide a number." << std::endl;
     } catch (const std::exception& e) {
+        commandStatus.failed = true;
         std::cout << "Error: " << e.what() << std::endl;
     }
 }
@@ -527,6 +773,7 @@ void handleDeleteTask(const std::vector<std::string>& args) {
 // Handle complete task command
 void handleCompleteTask(const std::vector<std::string>& args) {
     if (args.size() <= 1) {  // Show tasks if no ID provided (args[0] is "complete")
+        commandStatus.failed = true;
         auto tasksResult = db->getPendingTasks();
         if (!tasksResult) {
             TaskApp::handleError(tasksResult.error());
@@ -554,27 +801,25 @@ void handleCompleteTask(const std::vector<std::string>& args) {
         int taskId = std::stoi(args[1]);  // Use args[1] since args[0] is "complete"
         
         // Get task before marking as completed
-        auto tasksResult = db->getAllTasks();
-        if (!tasksResult) {
-            TaskApp::handleError(tasksResult.error());
+        auto taskResult = db->getTask(taskId);
+        if (!taskResult) {
+            TaskApp::handleError(taskResult.error());
             return;
         }
 
-        const auto& tasks = tasksResult.value();
-        auto it = std::find_if(tasks.begin(), tasks.end(), 
-                              [taskId](const Task& t) { return t.getId() == taskId; });
-        
-        if (it == tasks.end()) {
+        if (!taskResult.value()) {
+            commandStatus.failed = true;
             std::cout << "Task not found with ID: " << taskId << std::endl;
             return;
         }
+        commandStatus.taskId = taskId;
 
-        if (it->isCompleted()) {
+        if (taskResult.value()->isCompleted()) {
             std::cout << "Task is already completed." << std::endl;
             return;
         }
 
-        Task task = *it;
+        Task task = *taskResult.value();
         task.markCompleted();
         
         auto result = db->updateTask(task);
@@ -593,18 +838,212 @@ void handleCompleteTask(const std::vector<std::string>& args) {
                 std::cout << "Task notifications cancelled" << std::endl;
             }
         } else {
+            commandStatus.failed = true;
             std::cout << "Failed to mark task as completed" << std::endl;
         }
     } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
         std::cout << "Error: Invalid task ID. Please provide a number." << std::endl;
     } catch (const std::exception& e) {
+        commandStatus.failed = true;
         std::cout << "Error: " << e.what() << std::endl;
     }
 }
 
+// Splits "console,email" into registered channel names, without duplicates;
+// false if any name is unknown
+bool parseChannelList(const std::string& text, std::vector<std::string>& channels) {
+    channels.clear();
+    std::stringstream stream(text);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        name = trimString(name);
+        if (name.empty()) {
+            continue;
+        }
+        if (!channelRegistry->find(name)) {
+            return false;
+        }
+        if (std::find(channels.begin(), channels.end(), name) == channels.end()) {
+            channels.push_back(name);
+        }
+    }
+    return !channels.empty();
+}
+
+bool isBuiltInChannel(const std::string& channel) {
+    static const std::vector<std::string> builtIn = {"console", "email", "file", "webhook", "socket"};
+    return std::find(builtIn.begin(), builtIn.end(), channel) != builtIn.end();
+}
+
+std::string describeChannels() {
+    std::string text;
+    for (const auto& name : channelRegistry->getNames()) {
+        text += (text.empty() ? "" : ", ") + name;
+    }
+    return text;
+}
+
+std::string joinChannelList(const std::vector<std::string>& channels) {
+    std::string text;
+    for (const auto& channel : channels) {
+        if (!text.empty()) {
+            text += ',';
+        }
+        text += channel;
+    }
+    return text;
+}
+
+// Hands the reminder to one channel without waiting for delivery: durable
+// channels (email) are written to the outbox, configured or not, and every
+// other sink has its own dispatcher queue. False if a non-durable channel is
+// not configured or its queue is full, or the outbox write failed.
+bool submitToChannel(const ChannelRegistry::Channel& channel, const Task& task, const std::string& message,
+                     NotificationPriority priority, std::shared_ptr<DeliveryReceipt> receipt) {
+    if (channel.isDurable()) {
+        // Failed deliveries are retried from the outbox, and entries for an
+        // unconfigured channel wait there until it is configured. The
+        // receipt is not needed past the write.
+        return outbox->enqueue(channel.getName(), task, message, priority);
+    }
+    auto notifier = channel.getSink();
+    if (!notifier) {
+        return false;
+    }
+    return notifier->submitNotification(task, message, priority, std::move(receipt));
+}
+
+// Like submitToChannel, but outside the channel's delivery window the
+// reminder is held until the window opens: in the outbox for durable
+// channels, otherwise in the channel's deferred backlog
+bool deliverToChannel(const std::shared_ptr<ChannelRegistry::Channel>& channel, const Task& task,
+                      const std::string& message, NotificationPriority priority,
+                      std::shared_ptr<DeliveryReceipt> receipt) {
+    auto window = channel->getWindow();
+    auto now = std::chrono::system_clock::now();
+    if (!window || window->contains(now)) {
+        return submitToChannel(*channel, task, message, priority, std::move(receipt));
+    }
+
+    auto opensAt = window->nextOpening(now);
+    if (channel->isDurable()) {
+        return outbox->enqueue(channel->getName(), task, message, priority,
+                               deferredDelivery->reserveReleaseSlot(*channel, opensAt));
+    }
+    if (!channel->getSink()) {
+        return false;
+    }
+    return deferredDelivery->defer(channel, NotificationRequest{task, message, {}, priority, 0, std::move(receipt)},
+                                   opensAt);
+}
+
+// The console queue refuses reminders when full or while the dispatcher shuts
+// down; those are written to stderr rather than dropped silently
+void showOnConsole(const Task& task, const std::string& message, NotificationPriority priority,
+                   std::shared_ptr<DeliveryReceipt> receipt) {
+    if (!consoleNotifier->submitNotification(task, message, priority, std::move(receipt))) {
+        std::cerr << "Reminder for task #" << task.getId() << " (" << task.getDescription() << "): "
+                  << message << std::endl;
+    }
+}
+
+// Dispatched sinks have no retry, so a reminder one fails to deliver, at
+// hand-over or later (webhook responses), is shown on the console instead
+void attachSink(const std::shared_ptr<Notification>& sink, const std::string& channel) {
+    dispatcher->addSink(sink);
+    dispatcher->setFailureHandler(*sink,
+        [channel](const Task& task, const std::string& message, const std::exception& error) {
+            std::cerr << "Notification via " << channel << " failed, using console: " << error.what() << std::endl;
+            showOnConsole(task, message);
+        });
+}
+
+// Channel names are resolved to registry slots here, once; the slots' sinks
+// are read when the reminder fires, so a restored reminder uses whatever is
+// configured (or loaded as a plugin) by then. Every channel gets the reminder
+// even if an earlier one is unavailable; those fall back to a single console
+// notification.
+//
+// The fire is written to the ledger only once every channel's copy has been
+// handed to its sink or the outbox, or held for its delivery window. A copy
+// that is dropped, or still queued when the process dies, leaves the reminder
+// unrecorded, so it fires again on restart with the same idempotency key.
+Scheduler::Callback makeNotificationCallback(const std::string& channels, NotificationPriority priority) {
+    std::vector<std::shared_ptr<ChannelRegistry::Channel>> targets;
+    std::stringstream stream(channels);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        name = trimString(name);
+        try {
+            if (!name.empty()) {
+                targets.push_back(channelRegistry->add(name));
+            }
+        } catch (const NotificationException& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+    auto console = channelRegistry->add("console");
+
+    return [targets, console, priority](const Task& t, const std::string& msg) {
+        // Keyed like the schedule row: the time the reminder was armed for
+        auto triggerTime = t.getScheduledReminderTime();
+        auto receipt = std::make_shared<DeliveryReceipt>([taskId = t.getId(), triggerTime] {
+            if (fireLedger) {
+                fireLedger->recordFired(taskId, triggerTime);
+            }
+        });
+
+        bool toConsole = targets.empty();
+        for (const auto& channel : targets) {
+            if (channel == console) {
+                toConsole = true;
+            } else if (!deliverToChannel(channel, t, msg, priority, receipt)) {
+                std::cerr << "Notification via " << channel->getName() << " unavailable, using console" << std::endl;
+                toConsole = true;
+            }
+        }
+
+        if (toConsole && !deliverToChannel(console, t, msg, priority, receipt)) {
+            receipt->cancel();
+            std::cerr << "Console notification queue full, reminder for task #"
+                      << t.getId() << " will fire again on restart" << std::endl;
+        }
+    };
+}
+
+// Re-arm reminders saved by a previous run that never made it into the fire ledger
+size_t restoreScheduledNotifications() {
+    auto scheduled = db->getUnfiredNotifications();
+    if (!scheduled) {
+        TaskApp::handleError(scheduled.error());
+        return 0;
+    }
+
+    size_t restored = 0;
+    for (const auto& entry : scheduled.value()) {
+        auto priority = NotificationPriority::Normal;
+        if (entry.priority >= 0 && entry.priority < static_cast<int>(NotificationPriorityCount)) {
+            priority = static_cast<NotificationPriority>(entry.priority);
+        }
+        auto result = scheduler->restoreTask(entry.task, entry.triggerTime,
+                                             makeNotificationCallback(entry.channels, priority));
+        if (result && result.value()) {
+            ++restored;
+        }
+    }
+
+    if (restored < scheduled.value().size()) {
+        std::cerr << "Could not restore " << scheduled.value().size() - restored
+                  << " scheduled reminders" << std::endl;
+    }
+    return restored;
+}
+
 // Handle schedule task command
 void handleScheduleTask(const std::vector<std::string>& args) {
     if (args.size() <= 1) {  // Show tasks if no ID provided
+        commandStatus.failed = true;
         auto tasksResult = db->getPendingTasks();
         if (!tasksResult) {
             TaskApp::handleError(tasksResult.error());
@@ -621,61 +1060,64 @@ void handleScheduleTask(const std::vector<std::string>& args) {
         std::cout << "------------------------" << std::endl;
         for (const auto& task : tasks) {
             TaskApp::printTask(task);
-            std::cout << "Notification types: console, email" << std::endl;
+            std::cout << "Notification types: " << describeChannels() << std::endl;
             std::cout << "------------------------" << std::endl;
         }
-        std::cout << "Usage: schedule <id> <notification_type>" << std::endl;
-        std::cout << "Example: schedule 1 console" << std::endl;
+        std::cout << "Usage: schedule <id> <notification_type[,notification_type...]> [high|normal|low]" << std::endl;
+        std::cout << "Example: schedule 1 console,email,webhook high" << std::endl;
         return;
     }
     
     try {
         int taskId = std::stoi(args[1]);
-        std::string notificationType = "console";  // Default to console notification
+        std::vector<std::string> requested = {"console"};  // Default to console notification
         
-        if (args.size() >= 3) {
-            notificationType = args[2];
+        if (args.size() >= 3 && !parseChannelList(args[2], requested)) {
+            commandStatus.failed = true;
+            std::cout << "Unknown notification type in: " << args[2] << std::endl;
+            std::cout << "Notification types: " << describeChannels() << std::endl;
+            return;
         }
-        
-        // First get the task to schedule
-        auto tasksResult = db->getPendingTasks();
-        if (!tasksResult) {
-            TaskApp::handleError(tasksResult.error());
+
+        auto priority = NotificationPriority::Normal;
+        if (args.size() >= 4 && !parsePriority(args[3], priority)) {
+            commandStatus.failed = true;
+            std::cout << "Priority must be high, normal or low" << std::endl;
             return;
         }
         
-        const auto& tasks = tasksResult.value();
-        auto it = std::find_if(tasks.begin(), tasks.end(), 
-                              [taskId](const Task& t) {
-                                  return t.getId() == taskId;
-                              });
+        // First get the task to schedule; completed tasks are not scheduled
+        auto taskResult = db->getTask(taskId);
+        if (!taskResult) {
+            TaskApp::handleError(taskResult.error());
+            return;
+        }
         
-        if (it == tasks.end()) {
+        if (!taskResult.value() || taskResult.value()->isCompleted()) {
+            commandStatus.failed = true;
             std::cout << "Task not found with ID: " << taskId << std::endl;
             return;
         }
         
-        Task task = *it;
-        std::function<void(const Task&, const std::string&)> callback;
-        
-        if (notificationType == "email" && emailNotifier) {
-            callback = [](const Task& t, const std::string& msg) {
-                try {
-                    emailNotifier->sendNotification(t, msg);
-                } catch (const std::exception& e) {
-                    std::cerr << "Email notification failed: " << e.what() << std::endl;
-                    // Fallback to console notification
-                    consoleNotifier->sendNotification(t, msg);
-                }
-            };
-            std::cout << "Using email notification for task #" << taskId << std::endl;
-        } else {
-            // Default to console notification
-            callback = [](const Task& t, const std::string& msg) {
-                consoleNotifier->sendNotification(t, msg);
-            };
-            std::cout << "Using console notification for task #" << taskId << std::endl;
+        Task task = *taskResult.value();
+        commandStatus.taskId = taskId;
+
+        // The requested channels are kept as asked and resolved when the
+        // reminder fires, so one configured in the meantime is used
+        for (const auto& name : requested) {
+            auto slot = channelRegistry->find(name);
+            if (slot && !slot->getSink()) {
+                std::cout << "Channel " << name << " is not configured yet; "
+                          << (slot->isDurable() ? "its reminders wait in the outbox until it is"
+                                                : "the console is used if it still is not when the reminder fires")
+                          << std::endl;
+            }
         }
+        std::string channel = joinChannelList(requested);
+        std::cout << "Using " << channel << " notification for task #" << taskId
+                  << " (" << priorityName(priority) << " priority)" << std::endl;
+
+        auto callback = makeNotificationCallback(channel, priority);
         
         auto scheduleResult = scheduler->scheduleTask(task, callback);
         if (!scheduleResult) {
@@ -684,16 +1126,25 @@ void handleScheduleTask(const std::vector<std::string>& args) {
         }
         
         if (scheduleResult.value()) {
-            auto reminderTime = std::chrono::system_clock::to_time_t(task.getReminderTime());
-            std::tm tm = *std::localtime(&reminderTime);
-            std::cout << "Task #" << taskId << " scheduled for notification at: " 
-                     << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << std::endl;
+            // Saved so the reminder is re-armed if the process restarts before it fires
+            auto saveResult = db->saveScheduledNotification(task.getId(), task.getReminderTime(), channel,
+                                                            static_cast<int>(priority));
+            if (!saveResult) {
+                std::cerr << "Warning: reminder for task #" << taskId
+                          << " will not survive a restart: " << saveResult.error().message() << std::endl;
+            }
+
+            std::cout << "Task #" << taskId << " scheduled for notification at: "
+                     << TimeFormat::local(task.getReminderTime()) << std::endl;
         } else {
+            commandStatus.failed = true;
             std::cout << "Failed to schedule task #" << taskId << " for notification" << std::endl;
         }
     } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
         std::cout << "Error: Invalid task ID. Please provide a number." << std::endl;
     } catch (const std::exception& e) {
+        commandStatus.failed = true;
         std::cout << "Error: " << e.what() << std::endl;
     }
 }
@@ -734,14 +1185,15 @@ void handleCheckEvents(const std::vector<std::string>& args) {
 
 // Handle email setup command
 void handleEmailSetup(const std::vector<std::string>& args) {
-    if (args.size() != 4) {  // args[0] is "email" command
-        std::cout << "Usage: email <recipient> <smtp_server> <port>" << std::endl;
-        std::cout << "Example: email user@example.com smtp.gmail.com 587" << std::endl;
+    if (args.size() != 4 && args.size() != 5) {  // args[0] is "email" command
+        commandStatus.failed = true;
+        std::cout << "Usage: email <recipient[,recipient...]> <smtp_server> <port> [sessions]" << std::endl;
+        std::cout << "Example: email user@example.com,team@example.com smtp.gmail.com 587 4" << std::endl;
         return;
     }
     
     try {
-        std::string recipient = args[1];  // Changed from args[0] to args[1]
+        std::string recipientList = args[1];  // Changed from args[0] to args[1]
         std::string smtpServer = args[2]; // Changed from args[1] to args[2]
         int port;
         
@@ -751,39 +1203,874 @@ void handleEmailSetup(const std::vector<std::string>& args) {
                 throw std::invalid_argument("Port must be between 1 and 65535");
             }
         } catch (const std::exception&) {
+            commandStatus.failed = true;
             std::cout << "Invalid port number. Must be between 1 and 65535." << std::endl;
             return;
         }
         
-        // Validate email format using simple regex
-        static const std::regex email_regex(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-        if (!std::regex_match(recipient, email_regex)) {
-            std::cout << "Invalid email format. Please use a valid email address." << std::endl;
+        std::vector<std::string> recipients;
+        std::stringstream listStream(recipientList);
+        std::string recipient;
+        while (std::getline(listStream, recipient, ',')) {
+            recipient = trimString(recipient);
+            if (!EmailNotification::isValidAddress(recipient)) {
+                commandStatus.failed = true;
+                std::cout << "Invalid email format: '" << recipient << "'. Please use valid email addresses." << std::endl;
+                return;
+            }
+            recipients.push_back(recipient);
+        }
+
+        if (recipients.empty()) {
+            commandStatus.failed = true;
+            std::cout << "At least one recipient is required." << std::endl;
             return;
         }
 
-        emailNotifier = std::make_shared<EmailNotification>(recipient);
-        emailNotifier->setNotificationPrefix("[TASK REMINDER]");
-        emailNotifier->setSmtpServer(smtpServer);
-        emailNotifier->setSmtpPort(port);
-        emailNotifier->setSenderEmail("tasks@taskmanager.app");
+        auto notifier = std::make_shared<EmailNotification>(recipients.front());
+        if (args.size() == 5) {
+            int sessions = 0;
+            try {
+                sessions = std::stoi(args[4]);
+            } catch (const std::exception&) {
+            }
+            if (!notifier->setSessionCount(static_cast<size_t>(std::max(sessions, 0)))) {
+                commandStatus.failed = true;
+                std::cout << "Invalid session count. Must be between 1 and 64." << std::endl;
+                return;
+            }
+        }
+        notifier->setRecipients(recipients);
+        notifier->setNotificationPrefix("[TASK REMINDER]");
+        notifier->setSmtpServer(smtpServer);
+        notifier->setSmtpPort(port);
+        notifier->setSenderEmail("tasks@taskmanager.app");
+
+        // Replaces any previous email sink for pending and future outbox entries
+        outbox->registerChannel("email", notifier);
+        emailNotifier = notifier;
+        channelRegistry->bind("email", notifier);
         
         std::cout << "Email notifications configured successfully:" << std::endl;
-        std::cout << "  Recipient: " << recipient << std::endl;
+        for (const auto& address : notifier->getRecipients()) {
+            std::cout << "  Recipient: " << address << std::endl;
+        }
         std::cout << "  SMTP Server: " << smtpServer << std::endl;
         std::cout << "  Port: " << port << std::endl;
+        std::cout << "  SMTP sessions: " << notifier->getSessionCount() << std::endl;
         
     } catch (const NotificationException& e) {
+        commandStatus.failed = true;
         std::cout << "Failed to configure email: " << e.what() << std::endl;
     } catch (const std::exception& e) {
+        commandStatus.failed = true;
         std::cout << "Error configuring email: " << e.what() << std::endl;
     }
 }
 
+// Handle email recipients command
+void handleRecipients(const std::vector<std::string>& args) {
+    if (!emailNotifier) {
+        commandStatus.failed = true;
+        std::cout << "Email notifications are not configured. Use the 'email' command first." << std::endl;
+        return;
+    }
 
-// Handle exit command
-void handleExit(const std::vector<std::string>& args) {
-    (void)args;
-    std::cout << "Exiting Task Manager. Goodbye!" << std::endl;
-    running = false;
+    if (args.size() == 3 && args[1] == "add") {
+        if (!emailNotifier->addRecipient(args[2])) {
+            commandStatus.failed = true;
+            std::cout << "Cannot add recipient (invalid or already present): " << args[2] << std::endl;
+            return;
+        }
+    } else if (args.size() == 3 && args[1] == "remove") {
+        if (!emailNotifier->removeRecipient(args[2])) {
+            commandStatus.failed = true;
+            std::cout << "Cannot remove recipient (unknown or last one): " << args[2] << std::endl;
+            return;
+        }
+    } else if (args.size() != 1) {
+        commandStatus.failed = true;
+        std::cout << "Usage: recipients [add|remove <address>]" << std::endl;
+        return;
+    }
+
+    std::cout << "Email recipients:" << std::endl;
+    for (const auto& address : emailNotifier->getRecipients()) {
+        std::cout << "  " << address << std::endl;
+    }
+}
+
+// Handle email digest command
+void handleDigestSetup(const std::vector<std::string>& args) {
+    if (!emailNotifier) {
+        commandStatus.failed = true;
+        std::cout << "Email notifications are not configured. Use the 'email' command first." << std::endl;
+        return;
+    }
+
+    if (args.size() == 2 && args[1] == "off") {
+        emailNotifier->disableDigest();
+        size_t unsent = emailNotifier->getPendingDigestCount();
+        if (unsent > 0) {
+            commandStatus.failed = true;
+            std::cout << "Email digest disabled; " << unsent
+                      << " buffered reminders could not be sent and stay buffered until a digest is enabled again" << std::endl;
+        } else {
+            std::cout << "Email digest disabled; buffered reminders were sent" << std::endl;
+        }
+        return;
+    }
+
+    if (args.size() != 3) {
+        commandStatus.failed = true;
+        std::cout << "Usage: digest <window_minutes> <max_reminders> | digest off" << std::endl;
+        std::cout << "Example: digest 5 20" << std::endl;
+        return;
+    }
+
+    try {
+        int windowMinutes = std::stoi(args[1]);
+        int maxReminders = std::stoi(args[2]);
+        if (windowMinutes <= 0 || maxReminders <= 0 ||
+            !emailNotifier->setDigestPolicy(std::chrono::minutes(windowMinutes), static_cast<size_t>(maxReminders))) {
+            commandStatus.failed = true;
+            std::cout << "Window and reminder count must be positive numbers" << std::endl;
+            return;
+        }
+
+        std::cout << "Email digest enabled: up to " << maxReminders << " reminders per email, "
+                  << windowMinutes << " minute window" << std::endl;
+    } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: Invalid number. Usage: digest <window_minutes> <max_reminders>" << std::endl;
+    } catch (const std::exception& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+// Handle notification log command
+void handleFileLogSetup(const std::vector<std::string>& args) {
+    if (args.size() < 2 || args.size() > 4) {
+        commandStatus.failed = true;
+        std::cout << "Usage: filelog <path> [max_size_mb] [max_files]" << std::endl;
+        std::cout << "Example: filelog reminders.log 10 5" << std::endl;
+        return;
+    }
+
+    try {
+        int maxSizeMb = args.size() >= 3 ? std::stoi(args[2]) : 10;
+        int maxFiles = args.size() == 4 ? std::stoi(args[3]) : 5;
+
+        auto notifier = std::make_shared<FileNotification>(args[1]);
+        if (!notifier->setRotation(static_cast<std::uintmax_t>(maxSizeMb) * 1024 * 1024, maxFiles) || maxSizeMb <= 0) {
+            commandStatus.failed = true;
+            std::cout << "Size and file count must be positive numbers" << std::endl;
+            return;
+        }
+
+        // Replace any previous log; its queued records are written first
+        if (fileNotifier) {
+            dispatcher->removeSink(*fileNotifier);
+        }
+        attachSink(notifier, "file");
+        fileNotifier = notifier;
+        channelRegistry->bind("file", notifier);
+
+        std::cout << "Notification log configured successfully:" << std::endl;
+        std::cout << "  Path: " << notifier->getPath() << std::endl;
+        std::cout << "  Rotation: " << maxSizeMb << " MB x " << maxFiles << " files" << std::endl;
+    } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: Invalid number. Usage: filelog <path> [max_size_mb] [max_files]" << std::endl;
+    } catch (const NotificationException& e) {
+        commandStatus.failed = true;
+        std::cout << "Failed to configure notification log: " << e.what() << std::endl;
+    } catch (const std::exception& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+// Handle webhook command
+void handleWebhookSetup(const std::vector<std::string>& args) {
+    if (args.size() < 2 || args.size() > 4) {
+        commandStatus.failed = true;
+        std::cout << "Usage: webhook <url> [timeout_ms] [max_in_flight]" << std::endl;
+        std::cout << "Example: webhook http://localhost:8080/reminders 5000 32" << std::endl;
+        return;
+    }
+
+    try {
+        int timeoutMs = args.size() >= 3 ? std::stoi(args[2]) : 5000;
+        int maxInFlight = args.size() == 4 ? std::stoi(args[3]) : 32;
+
+        auto notifier = std::make_shared<WebhookNotification>(args[1]);
+        if (timeoutMs <= 0 || maxInFlight <= 0 ||
+            !notifier->setTimeout(std::chrono::milliseconds(timeoutMs)) ||
+            !notifier->setMaxInFlight(static_cast<size_t>(maxInFlight))) {
+            commandStatus.failed = true;
+            std::cout << "Timeout and in-flight limit must be positive numbers" << std::endl;
+            return;
+        }
+        notifier->setNotificationPrefix("[TASK]");
+
+        // The previous sink finishes its in-flight requests when released
+        if (webhookNotifier) {
+            dispatcher->removeSink(*webhookNotifier);
+        }
+        attachSink(notifier, "webhook");
+        webhookNotifier = notifier;
+        channelRegistry->bind("webhook", notifier);
+
+        std::cout << "Webhook notification configured successfully:" << std::endl;
+        std::cout << "  URL: " << notifier->getUrl() << std::endl;
+        std::cout << "  Timeout: " << timeoutMs << " ms, up to " << maxInFlight << " requests in flight" << std::endl;
+    } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: Invalid number. Usage: webhook <url> [timeout_ms] [max_in_flight]" << std::endl;
+    } catch (const NotificationException& e) {
+        commandStatus.failed = true;
+        std::cout << "Failed to configure webhook: " << e.what() << std::endl;
+    } catch (const std::exception& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+// Handle notification socket command
+void handleSocketSetup(const std::vector<std::string>& args) {
+    if (args.size() > 4) {
+        commandStatus.failed = true;
+        std::cout << "Usage: socket [<path> [buffer_kb] [drop|disconnect]]" << std::endl;
+        std::cout << "Example: socket /tmp/task_scheduler.sock 256 drop" << std::endl;
+        return;
+    }
+
+    if (args.size() >= 2) {
+        try {
+            int bufferKb = args.size() >= 3 ? std::stoi(args[2]) : 256;
+            auto policy = SocketNotification::SlowSubscriberPolicy::DropFrame;
+            if (args.size() == 4) {
+                if (args[3] == "disconnect") {
+                    policy = SocketNotification::SlowSubscriberPolicy::Disconnect;
+                } else if (args[3] != "drop") {
+                    commandStatus.failed = true;
+                    std::cout << "Slow subscriber policy must be 'drop' or 'disconnect'" << std::endl;
+                    return;
+                }
+            }
+            if (bufferKb <= 0) {
+                commandStatus.failed = true;
+                std::cout << "Buffer size must be a positive number" << std::endl;
+                return;
+            }
+
+            // Release the old socket first in case the path is reused
+            if (socketNotifier) {
+                dispatcher->removeSink(*socketNotifier);
+                socketNotifier.reset();
+                channelRegistry->bind("socket", nullptr);
+            }
+            auto notifier = std::make_shared<SocketNotification>(args[1]);
+            notifier->setBufferSize(static_cast<size_t>(bufferKb) * 1024);
+            notifier->setSlowSubscriberPolicy(policy);
+            attachSink(notifier, "socket");
+            socketNotifier = notifier;
+            channelRegistry->bind("socket", notifier);
+            std::cout << "Notification socket listening on " << notifier->getPath() << std::endl;
+        } catch (const std::invalid_argument& e) {
+            commandStatus.failed = true;
+            std::cout << "Error: Invalid number. Usage: socket <path> [buffer_kb] [drop|disconnect]" << std::endl;
+            return;
+        } catch (const NotificationException& e) {
+            commandStatus.failed = true;
+            std::cout << "Failed to open notification socket: " << e.what() << std::endl;
+            return;
+        } catch (const std::exception& e) {
+            commandStatus.failed = true;
+            std::cout << "Error: " << e.what() << std::endl;
+            return;
+        }
+    }
+
+    if (!socketNotifier) {
+        commandStatus.failed = true;
+        std::cout << "Notification socket is not configured. Use 'socket <path>' first." << std::endl;
+        return;
+    }
+
+    std::cout << "Notification socket " << socketNotifier->getPath() << ":" << std::endl;
+    std::cout << "  Subscribers: " << socketNotifier->getSubscriberCount() << std::endl;
+    std::cout << "  Buffer per subscriber: " << socketNotifier->getBufferSize() / 1024 << " KB" << std::endl;
+    std::cout << "  Slow subscriber policy: "
+              << SocketNotification::policyName(socketNotifier->getSlowSubscriberPolicy()) << std::endl;
+    std::cout << "  Dropped frames: " << socketNotifier->getDroppedFrames() << std::endl;
+    std::cout << "  Disconnected subscribers: " << socketNotifier->getDisconnectedCount() << std::endl;
+}
+
+// Handle outbox command
+void handleOutbox(const std::vector<std::string>& args) {
+    if (args.size() == 2 && args[1] == "drain") {
+        size_t delivered = outbox->drain();
+        std::cout << "Delivered " << delivered << " outbox notifications" << std::endl;
+    } else if (args.size() != 1) {
+        commandStatus.failed = true;
+        std::cout << "Usage: outbox [drain]" << std::endl;
+        return;
+    }
+
+    std::cout << "Pending outbox notifications: " << outbox->getPendingCount() << " (";
+    for (size_t lane = 0; lane < NotificationPriorityCount; ++lane) {
+        auto priority = static_cast<NotificationPriority>(lane);
+        std::cout << (lane > 0 ? ", " : "") << priorityName(priority) << " " << outbox->getPendingCount(priority);
+    }
+    std::cout << ")" << std::endl;
+}
+// Look up a configured notification channel by name
+std::shared_ptr<Notification> findNotifier(const std::string& channel) {
+    return channelRegistry->findSink(channel);
+}
+
+// Handle rate limit command
+void handleRateLimit(const std::vector<std::string>& args) {
+    if (args.size() < 2 || args.size() > 4) {
+        commandStatus.failed = true;
+        std::cout << "Usage: ratelimit <channel|recipient> [<per_second> [burst]|off]" << std::endl;
+        std::cout << "Example: ratelimit email 5 20" << std::endl;
+        return;
+    }
+
+    // Email's per-recipient limit is configured separately from the sink's
+    bool perRecipient = args[1] == "recipient";
+    std::shared_ptr<Notification> notifier = perRecipient ? emailNotifier : findNotifier(args[1]);
+    if (!notifier) {
+        commandStatus.failed = true;
+        std::cout << "Notification channel not available: " << (perRecipient ? "email" : args[1]) << std::endl;
+        return;
+    }
+    RateLimiter& limiter = notifier->getRateLimiter();
+
+    if (args.size() == 3 && args[2] == "off") {
+        if (perRecipient) {
+            emailNotifier->disableRecipientRateLimit();
+        } else {
+            limiter.disable();
+        }
+    } else if (args.size() >= 3) {
+        try {
+            double perSecond = std::stod(args[2]);
+            int burst = args.size() == 4 ? std::stoi(args[3]) : std::max(1, static_cast<int>(perSecond));
+            bool applied = burst > 0 &&
+                (perRecipient ? emailNotifier->setRecipientRateLimit(perSecond, static_cast<size_t>(burst))
+                              : limiter.setRate(perSecond, static_cast<size_t>(burst)));
+            if (!applied) {
+                commandStatus.failed = true;
+                std::cout << "Rate and burst must be positive numbers" << std::endl;
+                return;
+            }
+        } catch (const std::exception&) {
+            commandStatus.failed = true;
+            std::cout << "Error: Invalid number. Usage: ratelimit <channel|recipient> <per_second> [burst]" << std::endl;
+            return;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    if (perRecipient) {
+        double rate = emailNotifier->getRecipientRate();
+        std::cout << "Email per-recipient rate limit: ";
+        if (rate > 0.0) {
+            std::cout << rate << "/s, burst " << emailNotifier->getRecipientBurst() << std::endl;
+        } else {
+            std::cout << "off" << std::endl;
+        }
+    } else {
+        std::cout << "Rate limit for " << args[1] << ": ";
+        if (limiter.isEnabled()) {
+            std::cout << limiter.getRate() << "/s, burst " << limiter.getBurst() << std::endl;
+        } else {
+            std::cout << "off" << std::endl;
+        }
+        std::cout << "  Deferred requests: " << limiter.getLimitedCount() << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+// Handle notification statistics command
+void handleNotifyStats(const std::vector<std::string>& args) {
+    auto channels = channelRegistry->getNames();
+
+    if (args.size() > 2) {
+        commandStatus.failed = true;
+        std::cout << "Usage: notifystats [channel|reset]" << std::endl;
+        return;
+    }
+
+    if (args.size() == 2 && args[1] == "reset") {
+        for (const auto& channel : channels) {
+            if (auto notifier = findNotifier(channel)) {
+                notifier->getMetrics().reset();
+            }
+        }
+        std::cout << "Notification statistics reset" << std::endl;
+        return;
+    }
+
+    bool shown = false;
+    for (const auto& channel : channels) {
+        if (args.size() == 2 && args[1] != channel) {
+            continue;
+        }
+        auto notifier = findNotifier(channel);
+        if (!notifier) {
+            continue;
+        }
+        shown = true;
+
+        auto stats = notifier->getMetrics().snapshot();
+        auto printHistogram = [](const char* label, const DeliveryMetrics::Histogram& histogram) {
+            std::cout << "  " << label << " (ms): avg " << histogram.averageMs()
+                      << ", p50 " << histogram.percentileMs(0.50)
+                      << ", p95 " << histogram.percentileMs(0.95)
+                      << ", p99 " << histogram.percentileMs(0.99)
+                      << ", max " << histogram.maxMs() << std::endl;
+        };
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << channel << ":" << std::endl;
+        std::cout << "  Attempts: " << stats.attempts << " (succeeded " << stats.successes
+                  << ", failed " << stats.failures << "), deferred " << stats.deferred
+                  << ", rejected " << stats.rejected << std::endl;
+        printHistogram("Latency", stats.latency);
+        printHistogram("Queue age", stats.queueAge);
+
+        if (notifier->isDispatched()) {
+            double oldestMs = std::chrono::duration<double, std::milli>(dispatcher->getOldestQueuedAge(*notifier)).count();
+            std::cout << "  Queued now: " << dispatcher->getQueueDepth(*notifier) << " (";
+            for (size_t lane = 0; lane < NotificationPriorityCount; ++lane) {
+                auto priority = static_cast<NotificationPriority>(lane);
+                std::cout << priorityName(priority) << " " << dispatcher->getLaneDepth(*notifier, priority) << ", ";
+            }
+            std::cout << "oldest " << oldestMs << " ms), dropped " << dispatcher->getDroppedCount(*notifier) << std::endl;
+        }
+        if (channel == "email") {
+            std::cout << "  Outbox pending: " << outbox->getPendingCount() << std::endl;
+        }
+        std::cout << std::defaultfloat;
+    }
+
+    if (!shown) {
+        commandStatus.failed = args.size() == 2;
+        std::cout << (args.size() == 2 ? "Notification channel not available: " + args[1]
+                                       : std::string("No notification channels configured")) << std::endl;
+    }
+}
+
+// Handle priority lanes command
+void handleLanes(const std::vector<std::string>& args) {
+    if (args.size() == 2 || args.size() == 5) {
+        NotificationDispatcher::LanePolicy policy;
+        if (args[1] == "strict" && args.size() == 2) {
+            policy = NotificationDispatcher::LanePolicy::Strict;
+        } else if (args[1] == "weighted") {
+            policy = NotificationDispatcher::LanePolicy::Weighted;
+        } else {
+            commandStatus.failed = true;
+            std::cout << "Usage: lanes [strict|weighted [high normal low]]" << std::endl;
+            return;
+        }
+
+        if (args.size() == 5) {
+            NotificationDispatcher::LaneWeights weights;
+            try {
+                for (size_t lane = 0; lane < NotificationPriorityCount; ++lane) {
+                    int weight = std::stoi(args[lane + 2]);
+                    weights[lane] = weight > 0 ? static_cast<unsigned>(weight) : 0;
+                }
+            } catch (const std::exception&) {
+                weights.fill(0);
+            }
+            if (!dispatcher->setLaneWeights(weights)) {
+                commandStatus.failed = true;
+                std::cout << "Lane weights must be positive numbers" << std::endl;
+                return;
+            }
+        }
+        dispatcher->setLanePolicy(policy);
+    } else if (args.size() != 1) {
+        commandStatus.failed = true;
+        std::cout << "Usage: lanes [strict|weighted [high normal low]]" << std::endl;
+        return;
+    }
+
+    auto weights = dispatcher->getLaneWeights();
+    if (dispatcher->getLanePolicy() == NotificationDispatcher::LanePolicy::Strict) {
+        std::cout << "Priority lanes: strict (high, then normal, then low)" << std::endl;
+    } else {
+        std::cout << "Priority lanes: weighted " << weights[0] << "/" << weights[1] << "/" << weights[2]
+                  << " (high/normal/low)" << std::endl;
+    }
+}
+
+// Handle delivery window command
+void handleWindow(const std::vector<std::string>& args) {
+    if (args.size() == 3 && args[1] == "release") {
+        try {
+            if (!deferredDelivery->setReleaseRate(std::stod(args[2]))) {
+                commandStatus.failed = true;
+                std::cout << "Release rate must be a positive number" << std::endl;
+                return;
+            }
+        } catch (const std::exception&) {
+            commandStatus.failed = true;
+            std::cout << "Error: Invalid number. Usage: window release <per_second>" << std::endl;
+            return;
+        }
+    } else if (args.size() == 3) {
+        auto channel = channelRegistry->find(args[1]);
+        if (!channel) {
+            commandStatus.failed = true;
+            std::cout << "Unknown notification channel: " << args[1] << std::endl;
+            return;
+        }
+        if (args[2] == "off") {
+            // Held reminders still wait for the opening they were armed for
+            channel->setWindow(nullptr);
+        } else if (auto window = DeliveryWindow::parse(args[2])) {
+            channel->setWindow(window);
+        } else {
+            commandStatus.failed = true;
+            std::cout << "Window must look like 08:00-22:00 (local time)" << std::endl;
+            return;
+        }
+    } else if (args.size() != 1) {
+        commandStatus.failed = true;
+        std::cout << "Usage: window [<channel> <HH:MM-HH:MM|off>|release <per_second>]" << std::endl;
+        std::cout << "Example: window email 08:00-22:00" << std::endl;
+        return;
+    }
+
+    std::cout << "Delivery windows (deferred reminders released at " << deferredDelivery->getReleaseRate()
+              << "/s per channel):" << std::endl;
+    for (const auto& name : channelRegistry->getNames()) {
+        auto channel = channelRegistry->find(name);
+        auto window = channel->getWindow();
+        std::cout << "  " << name << ": " << (window ? window->toString() : "always");
+
+        size_t held = deferredDelivery->getBacklog(*channel);
+        if (held > 0) {
+            std::cout << ", " << held << " held until "
+                      << TimeFormat::local(deferredDelivery->getReleaseTime(*channel));
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Handle plugin command
+void handlePlugin(const std::vector<std::string>& args) {
+    if (args.size() >= 4 && args.size() <= 5 && args[1] == "load") {
+        const std::string& path = args[2];
+        const std::string& channel = args[3];
+        if (isBuiltInChannel(channel)) {
+            commandStatus.failed = true;
+            std::cout << "Channel " << channel << " is built in and cannot be replaced by a plugin" << std::endl;
+            return;
+        }
+
+        try {
+            auto previous = channelRegistry->findSink(channel);
+            auto sink = pluginLoader->load(path, channel, args.size() == 5 ? args[4] : "");
+            channelRegistry->bind(channel, sink);
+            // The previous sink drains its queue before it is released
+            if (previous) {
+                dispatcher->removeSink(*previous);
+            }
+            attachSink(sink, channel);
+            std::cout << "Plugin " << path << " loaded as channel " << channel << std::endl;
+        } catch (const NotificationException& e) {
+            commandStatus.failed = true;
+            std::cout << "Failed to load plugin: " << e.what() << std::endl;
+        } catch (const std::exception& e) {
+            commandStatus.failed = true;
+            std::cout << "Error: " << e.what() << std::endl;
+        }
+        return;
+    }
+
+    if (args.size() == 3 && args[1] == "unload") {
+        const std::string& channel = args[2];
+        if (!pluginLoader->isPluginChannel(channel)) {
+            commandStatus.failed = true;
+            std::cout << "No plugin is loaded as channel " << channel << std::endl;
+            return;
+        }
+
+        // Reminders already scheduled on the channel fall back to the console
+        auto sink = channelRegistry->findSink(channel);
+        channelRegistry->bind(channel, nullptr);
+        if (sink) {
+            dispatcher->removeSink(*sink);
+        }
+        pluginLoader->unload(channel);
+        std::cout << "Plugin channel " << channel << " unloaded" << std::endl;
+        return;
+    }
+
+    if (args.size() > 2 || (args.size() == 2 && args[1] != "list")) {
+        commandStatus.failed = true;
+        std::cout << "Usage: plugin [list|load <path> <channel> [config]|unload <channel>]" << std::endl;
+        std::cout << "Example: plugin load ./plugins/line_sink.so lines /tmp/reminders.txt" << std::endl;
+        return;
+    }
+
+    auto plugins = pluginLoader->getPlugins();
+    if (plugins.empty()) {
+        std::cout << "No plugins loaded" << std::endl;
+        return;
+    }
+    for (const auto& plugin : plugins) {
+        std::cout << "  " << plugin.channel << ": " << plugin.path << std::endl;
+    }
+}
+
+// Handle circuit breaker command
+void handleBreaker(const std::vector<std::string>& args) {
+    if (args.size() != 2 && args.size() != 4) {
+        commandStatus.failed = true;
+        std::cout << "Usage: breaker <channel> [threshold open_seconds]" << std::endl;
+        std::cout << "Example: breaker email 3 60" << std::endl;
+        return;
+    }
+
+    std::shared_ptr<Notification> notifier = findNotifier(args[1]);
+    if (!notifier) {
+        commandStatus.failed = true;
+        std::cout << "Notification channel not available: " << args[1] << std::endl;
+        return;
+    }
+
+    CircuitBreaker& breaker = notifier->getCircuitBreaker();
+
+    if (args.size() == 4) {
+        try {
+            int threshold = std::stoi(args[2]);
+            int openSeconds = std::stoi(args[3]);
+            if (!breaker.setFailureThreshold(threshold) ||
+                !breaker.setOpenDuration(std::chrono::seconds(openSeconds))) {
+                commandStatus.failed = true;
+                std::cout << "Threshold and open duration must be positive numbers" << std::endl;
+                return;
+            }
+        } catch (const std::exception&) {
+            commandStatus.failed = true;
+            std::cout << "Error: Invalid number. Usage: breaker <channel> <threshold> <open_seconds>" << std::endl;
+            return;
+        }
+    }
+
+    std::cout << "Circuit breaker for " << args[1] << ":" << std::endl;
+    std::cout << "  State: " << CircuitBreaker::stateName(breaker.getState()) << std::endl;
+    std::cout << "  Consecutive failures: " << breaker.getConsecutiveFailures()
+              << "/" << breaker.getFailureThreshold() << std::endl;
+    std::cout << "  Open duration: "
+              << std::chrono::duration_cast<std::chrono::seconds>(breaker.getOpenDuration()).count() << "s" << std::endl;
+}
+
+// Handle notification template command
+void handleTemplate(const std::vector<std::string>& args) {
+    if (args.size() != 2 && args.size() < 4) {
+        commandStatus.failed = true;
+        std::cout << "Usage: template <console|email> [subject|body <text>|default]" << std::endl;
+        std::cout << "Example: template email subject \"{prefix} {description} due {due}\"" << std::endl;
+        std::cout << "Placeholders: {id} {description} {due} {due_iso} {reminder} {status} {message} {prefix} {now}" << std::endl;
+        return;
+    }
+
+    std::shared_ptr<Notification> notifier;
+    if (args[1] == "console") {
+        notifier = consoleNotifier;
+    } else if (args[1] == "email") {
+        notifier = emailNotifier;
+    }
+
+    if (!notifier) {
+        commandStatus.failed = true;
+        std::cout << "Notification channel not available: " << args[1] << std::endl;
+        return;
+    }
+
+    if (args.size() >= 4) {
+        if (args[2] != "subject" && args[2] != "body") {
+            commandStatus.failed = true;
+            std::cout << "Template must be 'subject' or 'body'" << std::endl;
+            return;
+        }
+
+        // Remaining words form the text; a literal \n starts a new line
+        std::string text;
+        for (size_t i = 3; i < args.size(); ++i) {
+            if (i > 3) text += ' ';
+            text += args[i];
+        }
+        if (text == "default") {
+            text.clear();
+        }
+        for (size_t pos = text.find("\\n"); pos != std::string::npos; pos = text.find("\\n", pos + 1)) {
+            text.replace(pos, 2, "\n");
+        }
+
+        try {
+            if (!text.empty()) {
+                MessageTemplate compiled(text);
+            }
+        } catch (const TemplateException& e) {
+            commandStatus.failed = true;
+            std::cout << "Error: " << e.what() << std::endl;
+            return;
+        }
+
+        if (args[2] == "subject") {
+            notifier->setSubjectTemplate(text);
+        } else {
+            notifier->setBodyTemplate(text);
+        }
+    }
+
+    std::string subject = notifier->getSubjectTemplate();
+    std::string body = notifier->getBodyTemplate();
+    std::cout << "Templates for " << args[1] << ":" << std::endl;
+    std::cout << "  Subject: " << (subject.empty() ? "(default)" : subject) << std::endl;
+    std::cout << "  Body: " << (body.empty() ? "(default)" : body) << std::endl;
+}
+
+// Handle exit command
+void handleExit(const std::vector<std::string>& args) {
+    (void)args;
+    std::cout << "Exiting Task Manager. Goodbye!" << std::endl;
+    running = false;
+}
+
+// Handle test notification command
+void handleTestNotification(const std::vector<std::string>& args) {
+    if (args.size() < 2 || args.size() > 3) {
+        commandStatus.failed = true;
+        std::cout << "Usage: test <channel> [count]" << std::endl;
+        std::cout << "Example: test email 100" << std::endl;
+        return;
+    }
+
+    std::shared_ptr<Notification> notifier;
+    if (args[1] == "console") {
+        notifier = consoleNotifier;
+    } else if (args[1] == "email") {
+        if (!emailNotifier) {
+            commandStatus.failed = true;
+            std::cout << "Email notifications are not configured. Use the 'email' command first." << std::endl;
+            return;
+        }
+        notifier = emailNotifier;
+    } else if (args[1] == "file") {
+        if (!fileNotifier) {
+            commandStatus.failed = true;
+            std::cout << "Notification log is not configured. Use the 'filelog' command first." << std::endl;
+            return;
+        }
+        notifier = fileNotifier;
+    } else if (args[1] == "webhook") {
+        if (!webhookNotifier) {
+            commandStatus.failed = true;
+            std::cout << "Webhook notifications are not configured. Use the 'webhook' command first." << std::endl;
+            return;
+        }
+        webhookNotifier->resetStats();
+        notifier = webhookNotifier;
+    } else if (args[1] == "socket") {
+        if (!socketNotifier) {
+            commandStatus.failed = true;
+            std::cout << "Notification socket is not configured. Use the 'socket' command first." << std::endl;
+            return;
+        }
+        notifier = socketNotifier;
+    } else if (channelRegistry->find(args[1])) {
+        notifier = channelRegistry->findSink(args[1]);
+        if (!notifier) {
+            commandStatus.failed = true;
+            std::cout << "Notification channel " << args[1] << " is not configured" << std::endl;
+            return;
+        }
+    } else {
+        commandStatus.failed = true;
+        std::cout << "Unknown notification type: " << args[1] << std::endl;
+        return;
+    }
+
+    try {
+        int count = args.size() == 3 ? std::stoi(args[2]) : 1;
+        if (count <= 0) {
+            commandStatus.failed = true;
+            std::cout << "Count must be a positive number" << std::endl;
+            return;
+        }
+
+        auto now = std::chrono::system_clock::now();
+        Task task(0, "Test notification", 0, now, now + std::chrono::hours(1));
+
+        // Sent synchronously, bypassing the dispatcher, so the timing is the sink's own;
+        // still counted in the sink's delivery metrics
+        int delivered = 0;
+        auto started = std::chrono::steady_clock::now();
+        auto email = std::dynamic_pointer_cast<EmailNotification>(notifier);
+        if (email && count > 1) {
+            // One batch, spread over all SMTP sessions
+            std::vector<NotificationRequest> batch;
+            for (int i = 0; i < count; ++i) {
+                batch.push_back(NotificationRequest{task, "Test message " + std::to_string(i + 1)});
+            }
+            try {
+                email->deliverNotificationBatch(batch);
+                delivered = count;
+            } catch (const BatchDeliveryException& e) {
+                delivered = count - static_cast<int>(e.getFailedIndices().size() + e.getDeferredIndices().size());
+                std::cerr << "Test notification failed: " << e.what() << std::endl;
+            } catch (const NotificationException& e) {
+                std::cerr << "Test notification failed: " << e.what() << std::endl;
+            }
+        } else {
+            for (int i = 0; i < count; ++i) {
+                try {
+                    notifier->deliverNotification(task, "Test message " + std::to_string(i + 1));
+                    ++delivered;
+                } catch (const NotificationException& e) {
+                    std::cerr << "Test notification failed: " << e.what() << std::endl;
+                }
+            }
+        }
+        // Webhook requests complete asynchronously; time them to the last response
+        auto webhook = std::dynamic_pointer_cast<WebhookNotification>(notifier);
+        if (webhook && !webhook->waitUntilIdle(std::chrono::seconds(60))) {
+            std::cout << "Webhook requests still pending after 60s" << std::endl;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        if (webhook) {
+            auto stats = webhook->getStats();
+            delivered = static_cast<int>(stats.delivered);
+            std::cout << "Webhook: " << stats.failed << " failed, latency avg "
+                      << std::fixed << std::setprecision(2) << stats.averageLatencyMs << " ms, max "
+                      << stats.maxLatencyMs << " ms" << std::defaultfloat << std::endl;
+        }
+
+        commandStatus.failed = delivered < count;
+        std::cout << "Delivered " << delivered << "/" << count << " test notifications in "
+                  << std::fixed << std::setprecision(3) << seconds << "s";
+        if (seconds > 0.0) {
+            std::cout << " (" << std::setprecision(1) << delivered / seconds << " msg/s)";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    } catch (const std::invalid_argument& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: Invalid count. Please provide a number." << std::endl;
+    } catch (const std::exception& e) {
+        commandStatus.failed = true;
+        std::cout << "Error: " << e.what() << std::endl;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "../include/notifications/ChannelRegistry.hpp"
+#include "../include/database/Exceptions.hpp"
+
+ChannelRegistry::Channel::Channel(std::string name, bool durable)
+    : name(std::move(name)), durable(durable) {}
+
+const std::string& ChannelRegistry::Channel::getName() const noexcept {
+    return name;
+}
+
+bool ChannelRegistry::Channel::isDurable() const noexcept {
+    return durable;
+}
+
+std::shared_ptr<Notification> ChannelRegistry::Channel::getSink() const {
+    return sink.load(std::memory_order_acquire);
+}
+
+void ChannelRegistry::Channel::setSink(std::shared_ptr<Notification> notification) {
+    sink.store(std::move(notification), std::memory_order_release);
+}
+
+std::shared_ptr<const DeliveryWindow> ChannelRegistry::Channel::getWindow() const {
+    return window.load(std::memory_order_acquire);
+}
+
+void ChannelRegistry::Channel::setWindow(std::shared_ptr<const DeliveryWindow> deliveryWindow) {
+    window.store(std::move(deliveryWindow), std::memory_order_release);
+}
+
+std::shared_ptr<ChannelRegistry::Channel> ChannelRegistry::add(const std::string& name, bool durable) {
+    // Names end up in comma-separated channel lists
+    if (name.empty() || name.find_first_of(", \t") != std::string::npos) {
+        throw NotificationException("Invalid channel name: '" + name + "'");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byName.find(name);
+    if (it != byName.end()) {
+        return it->second;
+    }
+
+    auto channel = std::make_shared<Channel>(name, durable);
+    channels.push_back(channel);
+    byName.emplace(name, channel);
+    return channel;
+}
+
+std::shared_ptr<ChannelRegistry::Channel> ChannelRegistry::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = byName.find(name);
+    return it != byName.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<Notification> ChannelRegistry::findSink(const std::string& name) const {
+    auto channel = find(name);
+    return channel ? channel->getSink() : nullptr;
+}
+
+void ChannelRegistry::bind(const std::string& name, std::shared_ptr<Notification> sink) {
+    add(name)->setSink(std::move(sink));
+}
+
+std::vector<std::string> ChannelRegistry::getNames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> names;
+    names.reserve(channels.size());
+    for (const auto& channel : channels) {
+        names.push_back(channel->getName());
+    }
+    return names;
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "../include/notifications/CircuitBreaker.hpp"
+#include "../include/database/Exceptions.hpp"
+
+CircuitBreaker::CircuitBreaker(int failureThreshold,
+                               std::chrono::milliseconds openDuration,
+                               int halfOpenProbes)
+    : failureThreshold(failureThreshold)
+    , openDuration(openDuration)
+    , halfOpenProbes(halfOpenProbes) {
+    if (failureThreshold <= 0 || openDuration.count() <= 0 || halfOpenProbes <= 0) {
+        throw NotificationException("Invalid circuit breaker configuration");
+    }
+}
+
+bool CircuitBreaker::allowRequest() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (state == State::Open) {
+        if (std::chrono::steady_clock::now() - openedAt < openDuration) {
+            return false;
+        }
+        state = State::HalfOpen;
+        probesInFlight = 0;
+    }
+
+    if (state == State::HalfOpen) {
+        if (probesInFlight >= halfOpenProbes) {
+            return false;
+        }
+        ++probesInFlight;
+    }
+
+    return true;
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard<std::mutex> lock(mutex);
+    state = State::Closed;
+    consecutiveFailures = 0;
+    probesInFlight = 0;
+}
+
+void CircuitBreaker::recordFailure() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++consecutiveFailures;
+
+    // A failed probe re-opens immediately
+    if (state == State::HalfOpen || consecutiveFailures >= failureThreshold) {
+        open();
+    }
+}
+
+void CircuitBreaker::cancelRequest() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state == State::HalfOpen && probesInFlight > 0) {
+        --probesInFlight;
+    }
+}
+
+void CircuitBreaker::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    state = State::Closed;
+    consecutiveFailures = 0;
+    probesInFlight = 0;
+}
+
+// Caller holds mutex
+void CircuitBreaker::open() {
+    state = State::Open;
+    probesInFlight = 0;
+    openedAt = std::chrono::steady_clock::now();
+}
+
+bool CircuitBreaker::setFailureThreshold(int threshold) {
+    if (threshold <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    failureThreshold = threshold;
+    return true;
+}
+
+bool CircuitBreaker::setOpenDuration(const std::chrono::milliseconds& duration) {
+    if (duration.count() <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    openDuration = duration;
+    return true;
+}
+
+bool CircuitBreaker::setHalfOpenProbes(int probes) {
+    if (probes <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    halfOpenProbes = probes;
+    return true;
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return state;
+}
+
+int CircuitBreaker::getFailureThreshold() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failureThreshold;
+}
+
+std::chrono::milliseconds CircuitBreaker::getOpenDuration() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return openDuration;
+}
+
+int CircuitBreaker::getHalfOpenProbes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return halfOpenProbes;
+}
+
+int CircuitBreaker::getConsecutiveFailures() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return consecutiveFailures;
+}
+
+std::chrono::steady_clock::time_point CircuitBreaker::getRetryTime() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state != State::Open) {
+        return std::chrono::steady_clock::now();
+    }
+    return openedAt + openDuration;
+}
+
+std::string CircuitBreaker::stateName(State state) {
+    switch (state) {
+    case State::Closed:
+        return "closed";
+    case State::Open:
+        return "open";
+    case State::HalfOpen:
+        return "half-open";
+    default:
+        return "unknown";
+    }
+}
\ No newline at end of file
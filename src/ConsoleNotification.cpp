@@ -1,50 +1,35 @@
 #include "../include/notifications/ConsoleNotification.hpp"
-#include <iostream>
-#include <iomanip>
-#include <windows.h>
+#include "../include/core/TimeFormat.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
 #include <stdexcept>
-#include <memory>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace {
-    // Windows console color codes
-    constexpr int DEFAULT = 7;
-    constexpr int RED = FOREGROUND_RED | FOREGROUND_INTENSITY;
-    constexpr int GREEN = FOREGROUND_GREEN | FOREGROUND_INTENSITY;
-    constexpr int YELLOW = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY;
-    constexpr int BLUE = FOREGROUND_BLUE | FOREGROUND_INTENSITY;
-    
-    class ConsoleHandle {
-    private:
-        HANDLE handle;
-        WORD originalAttributes;
-        
-    public:
-        ConsoleHandle() : handle(GetStdHandle(STD_OUTPUT_HANDLE)) {
-            if (handle == INVALID_HANDLE_VALUE) {
-                throw NotificationException("Failed to get console handle");
-            }
-            CONSOLE_SCREEN_BUFFER_INFO info;
-            if (!GetConsoleScreenBufferInfo(handle, &info)) {
-                throw NotificationException("Failed to get console information");
-            }
-            originalAttributes = info.wAttributes;
-        }
-        
-        ~ConsoleHandle() {
-            SetConsoleTextAttribute(handle, originalAttributes);
-        }
-        
-        void setColor(int color) {
-            SetConsoleTextAttribute(handle, static_cast<WORD>(color));
-        }
-    };
+    // ANSI color escape codes
+    constexpr const char* RESET = "\x1b[0m";
+    constexpr const char* RED = "\x1b[1;31m";
+    constexpr const char* GREEN = "\x1b[1;32m";
+    constexpr const char* YELLOW = "\x1b[1;33m";
+    constexpr const char* BLUE = "\x1b[1;34m";
+
+    const std::string SEPARATOR(50, '=');
 }
 
 ConsoleNotification::ConsoleNotification() 
     : colorOutput(true)
     , verboseOutput(true)
     , useSound(true)
-    , isInitialized(false) {
+    , isInitialized(false)
+    , useStandardError(false)
+    , colorSupported(false) {
     if (!tryInitializeConsole()) {
         throw NotificationException("Failed to initialize console notification system");
     }
@@ -55,51 +40,136 @@ void ConsoleNotification::sendNotification(const Task& task, const std::string&
     try {
         validateInitialization();
         validateTaskData(task);
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        outputBuffer.clear();
+        formatNotification(outputBuffer, task, message);
+        writeOutput(outputBuffer);
         
-        std::unique_ptr<ConsoleHandle> console;
-        if (colorOutput) {
-            console = std::make_unique<ConsoleHandle>();
+    } catch (const std::exception& e) {
+        throw NotificationException("Failed to send console notification: " + std::string(e.what()));
+    }
+}
+
+void ConsoleNotification::sendNotificationBatch(const std::vector<NotificationRequest>& batch) {
+    try {
+        validateInitialization();
+        for (const auto& request : batch) {
+            validateTaskData(request.task);
         }
-        
-        // Get current time once and store it
-        std::time_t currentTime = std::time(nullptr);
-        std::tm* timeinfo = std::localtime(&currentTime);
-        
-        // Print notification header
-        if (colorOutput) console->setColor(YELLOW);
-        std::cout << "\n" << std::string(50, '=') << "\n";
-        std::cout << getNotificationPrefix() << " [" 
-                 << std::put_time(timeinfo, "%Y-%m-%d %H:%M:%S")
-                 << "]\n";
-        std::cout << std::string(50, '=') << "\n";
-
-        // Print task details
-        if (colorOutput) console->setColor(GREEN);
-        std::cout << "Task #" << task.getId() << ": " << task.getDescription() << "\n";
-
-        if (verboseOutput) {
-            if (colorOutput) console->setColor(BLUE);
-            auto dueTime = std::chrono::system_clock::to_time_t(task.getDueDate());
-            std::cout << "Due: " << std::put_time(std::localtime(&dueTime), "%Y-%m-%d %H:%M:%S") << "\n";
-            std::cout << "Reminder: " << task.getReminderMinutes() << " minutes before due\n";
-            std::cout << "Status: " << (task.isCompleted() ? "Completed" : "Pending") << "\n";
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        outputBuffer.clear();
+        for (const auto& request : batch) {
+            formatNotification(outputBuffer, request.task, request.message);
         }
+        writeOutput(outputBuffer);
 
-        // Print message
-        if (colorOutput) console->setColor(RED);
-        std::cout << "\nMessage: " << message << "\n";
-        
-        // Print footer
-        if (colorOutput) console->setColor(YELLOW);
-        std::cout << std::string(50, '=') << "\n" << std::endl;
+    } catch (const std::exception& e) {
+        throw NotificationException("Failed to send console notifications: " + std::string(e.what()));
+    }
+}
+
+void ConsoleNotification::formatNotification(std::string& out, const Task& task, const std::string& message) const {
+    bool color = colorOutput && colorSupported;
+    auto setColor = [&out, color](const char* code) {
+        if (color) out += code;
+    };
 
-        // Play sound if enabled
-        if (useSound) {
-            MessageBeep(MB_ICONINFORMATION);
+    auto subject = subjectTemplate();
+    auto body = bodyTemplate();
+
+    // Print notification header
+    setColor(YELLOW);
+    out += '\n';
+    out += SEPARATOR;
+    out += '\n';
+    if (subject) {
+        subject->render(out, task, message, notificationPrefix);
+    } else {
+        out += notificationPrefix;
+        out += " [";
+        TimeFormat::appendLocal(out, std::chrono::system_clock::now());
+        out += ']';
+    }
+    out += '\n';
+    out += SEPARATOR;
+    out += '\n';
+
+    // A body template replaces the built-in task details and message
+    if (body) {
+        setColor(GREEN);
+        body->render(out, task, message, notificationPrefix);
+        if (out.back() != '\n') {
+            out += '\n';
         }
-        
-    } catch (const std::exception& e) {
-        throw NotificationException("Failed to send console notification: " + std::string(e.what()));
+    } else {
+        formatDetails(out, task, message, color);
+    }
+
+    // Print footer
+    setColor(YELLOW);
+    out += SEPARATOR;
+    out += "\n\n";
+    setColor(RESET);
+
+    // Terminal bell if enabled
+    if (useSound) {
+        out += '\a';
+    }
+}
+
+void ConsoleNotification::formatDetails(std::string& out, const Task& task, const std::string& message, bool color) const {
+    auto setColor = [&out, color](const char* code) {
+        if (color) out += code;
+    };
+
+    // Print task details
+    setColor(GREEN);
+    out += "Task #";
+    out += std::to_string(task.getId());
+    out += ": ";
+    out += task.getDescription();
+    out += '\n';
+
+    if (verboseOutput) {
+        setColor(BLUE);
+        out += "Due: ";
+        TimeFormat::appendLocal(out, task.getDueDate());
+        out += "\nReminder: ";
+        out += std::to_string(task.getReminderMinutes());
+        out += " minutes before due\nStatus: ";
+        out += task.isCompleted() ? "Completed" : "Pending";
+        out += '\n';
+    }
+
+    // Print message
+    setColor(RED);
+    out += "\nMessage: ";
+    out += message;
+    out += '\n';
+}
+
+void ConsoleNotification::writeOutput(const std::string& out) const {
+    // Anything buffered by stdio goes first so output stays in order
+    std::fflush(useStandardError ? stderr : stdout);
+
+    const char* data = out.data();
+    size_t remaining = out.size();
+    while (remaining > 0) {
+#ifdef _WIN32
+        int written = _write(useStandardError ? 2 : 1, data, static_cast<unsigned int>(remaining));
+#else
+        ssize_t written = ::write(useStandardError ? STDERR_FILENO : STDOUT_FILENO, data, remaining);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw NotificationException("Failed to write to console");
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
     }
 }
 
@@ -121,6 +191,16 @@ bool ConsoleNotification::setNotificationSound(bool enable) {
     return true;
 }
 
+bool ConsoleNotification::setStandardError(bool enable) {
+    validateInitialization();
+    std::lock_guard<std::mutex> lock(outputMutex);
+    useStandardError = enable;
+#ifndef _WIN32
+    colorSupported = isatty(enable ? STDERR_FILENO : STDOUT_FILENO) != 0;
+#endif
+    return true;
+}
+
 bool ConsoleNotification::isColorOutputEnabled() const noexcept {
     return colorOutput;
 }
@@ -133,6 +213,10 @@ bool ConsoleNotification::isNotificationSoundEnabled() const noexcept {
     return useSound;
 }
 
+bool ConsoleNotification::isStandardErrorEnabled() const noexcept {
+    return useStandardError;
+}
+
 void ConsoleNotification::validateInitialization() const {
     if (!isInitialized) {
         throw NotificationException("Console notification system not initialized");
@@ -149,11 +233,18 @@ void ConsoleNotification::validateTaskData(const Task& task) const {
 }
 
 bool ConsoleNotification::tryInitializeConsole() {
-    try {
-        // Test console handle and color support
-        ConsoleHandle testHandle;
-        return true;
-    } catch (...) {
+#ifdef _WIN32
+    // Windows 10+ consoles interpret ANSI escapes once VT processing is on
+    HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (handle == INVALID_HANDLE_VALUE) {
         return false;
     }
+    DWORD mode = 0;
+    if (GetConsoleMode(handle, &mode)) {
+        colorSupported = SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+    }
+#else
+    colorSupported = isatty(STDOUT_FILENO) != 0;
+#endif
+    return true;
 }
\ No newline at end of file
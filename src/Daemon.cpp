@@ -0,0 +1,469 @@
+#include "../include/core/Daemon.hpp"
+#include "../include/core/CLI.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+int runDaemon(const std::string&, const std::string&) {
+    std::cerr << "Daemon mode needs Unix domain sockets and is not supported on Windows" << std::endl;
+    return 2;
+}
+
+int runClient(const std::string&) {
+    std::cerr << "Daemon mode needs Unix domain sockets and is not supported on Windows" << std::endl;
+    return 2;
+}
+
+#else
+
+namespace {
+    constexpr size_t ReadChunk = 64 * 1024;
+    // A client is not read from while this much of its answers is unsent
+    constexpr size_t MaxPendingOutput = 4 * 1024 * 1024;
+    // Longest command line; a client sending more is disconnected
+    constexpr size_t MaxLineLength = 1024 * 1024;
+    constexpr size_t MaxClients = 256;
+
+    // SIGINT and SIGTERM wake the event loop through this pipe
+    int signalFds[2]{-1, -1};
+
+    void onSignal(int) {
+        char byte = 0;
+        [[maybe_unused]] ssize_t written = ::write(signalFds[1], &byte, 1);
+    }
+
+    struct Client {
+        int fd{-1};
+        std::string input;
+        std::string output;
+        size_t sent{0};
+        size_t lines{0};
+        bool endOfInput{false};  // the client sent everything it will send
+        bool exited{false};      // exit was run; later lines are ignored
+        bool failed{false};      // connection error; close now
+
+        bool pendingOutput() const { return sent < output.size(); }
+        bool done() const { return failed || ((endOfInput || exited) && !pendingOutput()); }
+    };
+
+    bool makeAddress(const std::string& path, sockaddr_un& address) {
+        address = sockaddr_un{};
+        address.sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    // A socket file left behind by an earlier run is replaced, a live one is not
+    int openListener(const std::string& path) {
+        sockaddr_un address;
+        if (!makeAddress(path, address)) {
+            std::cerr << "Daemon socket path is empty or too long: " << path << std::endl;
+            return -1;
+        }
+
+        struct stat info;
+        if (::lstat(path.c_str(), &info) == 0) {
+            if (!S_ISSOCK(info.st_mode)) {
+                std::cerr << "Daemon socket path exists and is not a socket: " << path << std::endl;
+                return -1;
+            }
+            int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            bool inUse = probe >= 0 &&
+                         ::connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+            if (probe >= 0) {
+                ::close(probe);
+            }
+            if (inUse) {
+                std::cerr << "A daemon is already serving " << path << std::endl;
+                return -1;
+            }
+            ::unlink(path.c_str());
+        }
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0 ||
+            ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(fd, 64) != 0) {
+            std::cerr << "Failed to listen on " << path << ": " << std::strerror(errno) << std::endl;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return -1;
+        }
+        // Commands run with the daemon's rights, so only its user may connect
+        ::chmod(path.c_str(), 0600);
+        return fd;
+    }
+
+    // Reads what is available, at most one chunk so every client gets a turn
+    void readClient(Client& client) {
+        char buffer[ReadChunk];
+        ssize_t n = ::recv(client.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0) {
+            client.input.append(buffer, static_cast<size_t>(n));
+        } else if (n == 0) {
+            client.endOfInput = true;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            client.failed = true;
+        }
+    }
+
+    void writeClient(Client& client) {
+        while (client.sent < client.output.size()) {
+            ssize_t written = ::send(client.fd, client.output.data() + client.sent,
+                                     client.output.size() - client.sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    client.failed = true;
+                }
+                return;
+            }
+            client.sent += static_cast<size_t>(written);
+        }
+        client.output.clear();
+        client.sent = 0;
+    }
+
+    // Last answers before the daemon stops; a client that does not read
+    // within a second loses them
+    void flushBeforeClose(Client& client) {
+        while (!client.failed && client.pendingOutput()) {
+            pollfd ready{client.fd, POLLOUT, 0};
+            if (::poll(&ready, 1, 1000) <= 0) {
+                return;
+            }
+            writeClient(client);
+        }
+    }
+
+    // Writes all of data to fd, which may be non-blocking
+    bool writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    pollfd ready{fd, POLLOUT, 0};
+                    ::poll(&ready, 1, -1);
+                    continue;
+                }
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+}
+
+int runDaemon(const std::string& dbPath, const std::string& socketPath) {
+    if (::pipe2(signalFds, O_NONBLOCK | O_CLOEXEC) != 0) {
+        std::cerr << "Failed to create signal pipe: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    int listenFd = openListener(socketPath);
+    if (listenFd < 0) {
+        for (int& fd : signalFds) {
+            ::close(fd);
+            fd = -1;
+        }
+        return 1;
+    }
+
+    struct sigaction action{};
+    action.sa_handler = onSignal;
+    ::sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+
+    int exitCode = 0;
+    try {
+        if (!startServices(dbPath, false)) {
+            stopServices();
+            ::close(listenFd);
+            ::unlink(socketPath.c_str());
+            return 1;
+        }
+        startEventChecker();
+        std::cout << "Task daemon serving " << dbPath << " on " << socketPath << std::endl;
+
+        std::unordered_map<int, std::unique_ptr<Client>> clients;
+        int nextId = 0;
+        Client* current = nullptr;
+        bool stopping = false;
+
+        // exit ends the connection instead of the process
+        auto commandMap = makeCommandMap();
+        commandMap["exit"] = [&current](const std::vector<std::string>&) {
+            current->exited = true;
+            std::cout << "Goodbye" << std::endl;
+        };
+        commandMap["quit"] = commandMap["exit"];
+        commandMap["shutdown"] = [&stopping](const std::vector<std::string>&) {
+            stopping = true;
+            std::cout << "Daemon shutting down" << std::endl;
+        };
+
+        CommandBatch batch(std::move(commandMap), [&clients](int id, const std::string& result) {
+            auto it = clients.find(id);
+            if (it != clients.end()) {
+                it->second->output += result;
+            }
+        });
+
+        std::vector<pollfd> fds;
+        std::vector<int> polled;
+        while (!stopping) {
+            fds.clear();
+            polled.clear();
+            fds.push_back({signalFds[0], POLLIN, 0});
+            fds.push_back({listenFd, POLLIN, 0});
+            for (auto& [id, client] : clients) {
+                short events = 0;
+                if (!client->endOfInput && !client->exited &&
+                    client->output.size() - client->sent < MaxPendingOutput) {
+                    events |= POLLIN;
+                }
+                if (client->pendingOutput()) {
+                    events |= POLLOUT;
+                }
+                fds.push_back({client->fd, events, 0});
+                polled.push_back(id);
+            }
+
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Daemon poll failed: " << std::strerror(errno) << std::endl;
+                exitCode = 1;
+                break;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                std::cout << "Signal received, shutting down" << std::endl;
+                stopping = true;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                while (true) {
+                    int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (fd < 0) {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                            std::cerr << "Failed to accept daemon client: " << std::strerror(errno) << std::endl;
+                        }
+                        break;
+                    }
+                    if (clients.size() >= MaxClients) {
+                        ::close(fd);
+                        continue;
+                    }
+                    auto client = std::make_unique<Client>();
+                    client->fd = fd;
+                    clients.emplace(nextId++, std::move(client));
+                }
+            }
+
+            // Every complete line read in this round runs before any answer
+            // is sent, so pipelined writes share a transaction
+            for (size_t i = 0; i < polled.size(); ++i) {
+                Client& client = *clients.at(polled[i]);
+                short revents = fds[i + 2].revents;
+                if (revents & (POLLIN | POLLHUP)) {
+                    readClient(client);
+                } else if (revents & (POLLERR | POLLNVAL)) {
+                    client.failed = true;
+                }
+
+                current = &client;
+                size_t start = 0;
+                size_t end;
+                while (!client.exited && (end = client.input.find('\n', start)) != std::string::npos) {
+                    size_t length = end - start;
+                    if (length > 0 && client.input[end - 1] == '\r') {
+                        --length;
+                    }
+                    batch.run(polled[i], ++client.lines, client.input.substr(start, length));
+                    start = end + 1;
+                }
+                client.input.erase(0, start);
+
+                // An unterminated last line still counts once the client stops sending
+                if (client.endOfInput && !client.exited && !client.input.empty()) {
+                    batch.run(polled[i], ++client.lines, client.input);
+                    client.input.clear();
+                } else if (client.exited) {
+                    client.input.clear();
+                } else if (client.input.size() > MaxLineLength) {
+                    client.failed = true;
+                }
+                current = nullptr;
+            }
+            batch.flush();
+
+            for (auto it = clients.begin(); it != clients.end();) {
+                Client& client = *it->second;
+                if (!client.failed && client.pendingOutput()) {
+                    writeClient(client);
+                }
+                if (client.done()) {
+                    ::close(client.fd);
+                    it = clients.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        // Answers already produced (including the one to shutdown) go out before closing
+        batch.flush();
+        for (auto& [id, client] : clients) {
+            flushBeforeClose(*client);
+            ::close(client->fd);
+        }
+        clients.clear();
+    } catch (const std::exception& e) {
+        std::cerr << "Daemon error: " << e.what() << std::endl;
+        exitCode = 1;
+    }
+
+    ::close(listenFd);
+    ::unlink(socketPath.c_str());
+    stopServices();
+
+    ::signal(SIGINT, SIG_DFL);
+    ::signal(SIGTERM, SIG_DFL);
+    for (int& fd : signalFds) {
+        ::close(fd);
+        fd = -1;
+    }
+    return exitCode;
+}
+
+int runClient(const std::string& socketPath) {
+    sockaddr_un address;
+    if (!makeAddress(socketPath, address)) {
+        std::cerr << "Daemon socket path is empty or too long: " << socketPath << std::endl;
+        return 2;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Cannot connect to the task daemon at " << socketPath << ": " << std::strerror(errno) << std::endl;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return 2;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // Requests are sent as stdin provides them while answers stream back, so
+    // neither side waits on the other
+    std::string requests;
+    size_t requestsSent = 0;
+    bool inputDone = false;
+    bool writeShut = false;
+    std::string answers;
+    size_t failures = 0;
+    char buffer[ReadChunk];
+
+    while (true) {
+        pollfd fds[2] = {
+            {inputDone || requests.size() - requestsSent >= MaxPendingOutput ? -1 : STDIN_FILENO, POLLIN, 0},
+            {fd, static_cast<short>(POLLIN | (requestsSent < requests.size() ? POLLOUT : 0)), 0},
+        };
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        if (fds[0].revents & (POLLIN | POLLHUP)) {
+            ssize_t n = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (n > 0) {
+                requests.append(buffer, static_cast<size_t>(n));
+            } else if (n == 0 || errno != EINTR) {
+                inputDone = true;
+                if (!requests.empty() && requests.back() != '\n') {
+                    requests += '\n';
+                }
+            }
+        }
+
+        if (requestsSent < requests.size()) {
+            ssize_t written = ::send(fd, requests.data() + requestsSent, requests.size() - requestsSent, MSG_NOSIGNAL);
+            if (written > 0) {
+                requestsSent += static_cast<size_t>(written);
+                if (requestsSent == requests.size()) {
+                    requests.clear();
+                    requestsSent = 0;
+                }
+            } else if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "Lost connection to the task daemon: " << std::strerror(errno) << std::endl;
+                ::close(fd);
+                return 2;
+            }
+        }
+        if (inputDone && requests.empty() && !writeShut) {
+            ::shutdown(fd, SHUT_WR);
+            writeShut = true;
+        }
+
+        if (fds[1].revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (n == 0) {
+                break;
+            }
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "Lost connection to the task daemon: " << std::strerror(errno) << std::endl;
+                break;
+            }
+
+            // Answers are passed through whole; quotes inside strings are
+            // escaped, so the field can only match itself
+            answers.append(buffer, static_cast<size_t>(n));
+            size_t complete = answers.rfind('\n');
+            if (complete != std::string::npos) {
+                for (size_t pos = answers.find(",\"ok\":false"); pos < complete;
+                     pos = answers.find(",\"ok\":false", pos + 1)) {
+                    ++failures;
+                }
+                writeAll(STDOUT_FILENO, answers.data(), complete + 1);
+                answers.erase(0, complete + 1);
+            }
+        }
+    }
+
+    ::close(fd);
+    return failures == 0 ? 0 : 1;
+}
+
+#endif
\ No newline at end of file
@@ -112,6 +112,37 @@ Result<bool> Database::initializeDatabase() {
         "created_at INTEGER NOT NULL,"            // Changed to match other references
         "due_date INTEGER NOT NULL,"
         "completed INTEGER DEFAULT 0"
+        ");"
+        // Undelivered notifications; rows are removed only after successful delivery
+        "CREATE TABLE IF NOT EXISTS notification_outbox ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "channel TEXT NOT NULL,"
+        "task_id INTEGER NOT NULL,"
+        "description TEXT NOT NULL,"
+        "reminder_minutes INTEGER NOT NULL,"
+        "created_at INTEGER NOT NULL,"
+        "due_date INTEGER NOT NULL,"
+        "message TEXT NOT NULL,"
+        "attempts INTEGER NOT NULL DEFAULT 0,"
+        "next_attempt_ms INTEGER NOT NULL,"
+        "last_error TEXT,"
+        "priority INTEGER NOT NULL DEFAULT 1,"
+        "reminder_at INTEGER NOT NULL DEFAULT 0"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_outbox_next_attempt ON notification_outbox(next_attempt_ms);"
+        // Reminders to re-arm after a restart, and the ledger of ones that already fired
+        "CREATE TABLE IF NOT EXISTS scheduled_notifications ("
+        "task_id INTEGER NOT NULL,"
+        "trigger_at INTEGER NOT NULL,"
+        "channels TEXT NOT NULL,"
+        "priority INTEGER NOT NULL DEFAULT 1,"
+        "PRIMARY KEY (task_id, trigger_at)"
+        ");"
+        "CREATE TABLE IF NOT EXISTS fire_ledger ("
+        "task_id INTEGER NOT NULL,"
+        "trigger_at INTEGER NOT NULL,"
+        "fired_at INTEGER NOT NULL,"
+        "PRIMARY KEY (task_id, trigger_at)"
         ");";
 
     char* errMsg = nullptr;
@@ -122,6 +153,14 @@ Result<bool> Database::initializeDatabase() {
         sqlite3_free(errMsg);
         return Result<bool>(std::error_code(rc, std::generic_category()));
     }
+
+    try {
+        addColumnIfMissing("notification_outbox", "priority", "INTEGER NOT NULL DEFAULT 1");
+        addColumnIfMissing("notification_outbox", "reminder_at", "INTEGER NOT NULL DEFAULT 0");
+        addColumnIfMissing("scheduled_notifications", "priority", "INTEGER NOT NULL DEFAULT 1");
+    } catch (const DatabaseException& e) {
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
     
     return Result<bool>(true);
 }
@@ -319,6 +358,95 @@ Result<std::vector<Task>> Database::getAllTasks() {
     }
 }
 
+Result<std::optional<Task>> Database::getTask(int taskId) {
+
+    if (!isConnected()) {
+        return make_unexpected<std::optional<Task>>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    try {
+        const char* sql =
+        "SELECT id, description, reminder_minutes, created_at, due_date, completed FROM tasks WHERE id = ?;";
+
+        sqlite3_stmt* stmt;
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare task query: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        if (sqlite3_bind_int(stmt, 1, taskId) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            throw QueryException("Failed to bind task ID parameter");
+        }
+
+        std::optional<Task> task;
+        int result = sqlite3_step(stmt);
+        if (result == SQLITE_ROW) {
+            try {
+                task = taskFromStatement(stmt);
+            } catch (...) {
+                sqlite3_finalize(stmt);
+                throw;
+            }
+        }
+        sqlite3_finalize(stmt);
+
+        if (result != SQLITE_ROW && result != SQLITE_DONE) {
+            throw QueryException("Error while fetching task: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        return Result<std::optional<Task>>(std::move(task));
+
+    } catch (const DatabaseException& e) {
+        return make_unexpected<std::optional<Task>>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<size_t> Database::streamTasks(bool pendingOnly, const std::function<void(const TaskRow&)>& visit) {
+
+    if (!isConnected()) {
+        return make_unexpected<size_t>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    const char* sql = pendingOnly
+        ? "SELECT id, description, reminder_minutes, created_at, due_date, completed "
+          "FROM tasks WHERE completed = 0 ORDER BY id;"
+        : "SELECT id, description, reminder_minutes, created_at, due_date, completed FROM tasks ORDER BY id;";
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        return make_unexpected<size_t>(makeErrorCode(DbError::QueryFailed));
+    }
+
+    size_t count = 0;
+    int result;
+    try {
+        while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+            const char* description = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+            TaskRow row{
+                sqlite3_column_int(stmt, 0),
+                description ? std::string_view(description, static_cast<size_t>(sqlite3_column_bytes(stmt, 1)))
+                            : std::string_view(),
+                sqlite3_column_int(stmt, 2),
+                static_cast<std::int64_t>(sqlite3_column_int64(stmt, 3)),
+                static_cast<std::int64_t>(sqlite3_column_int64(stmt, 4)),
+                sqlite3_column_int(stmt, 5) == 1,
+            };
+            visit(row);
+            ++count;
+        }
+    } catch (...) {
+        sqlite3_finalize(stmt);
+        throw;
+    }
+    sqlite3_finalize(stmt);
+
+    if (result != SQLITE_DONE) {
+        return make_unexpected<size_t>(makeErrorCode(DbError::QueryFailed));
+    }
+    return Result<size_t>(count);
+}
+
 Result<std::vector<Task>> Database::getPendingTasks() {
     
     if (!isConnected()) {
@@ -409,6 +537,271 @@ Result<std::vector<Task>> Database::getDeletedTasks() {
     }
 }
 
+Result<int> Database::enqueueOutboxEntry(const std::string& channel, const Task& task, const std::string& message,
+                                         int priority, std::chrono::system_clock::time_point firstAttempt) {
+    if (!isConnected()) {
+        return make_unexpected<int>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    if (channel.empty()) {
+        return make_unexpected<int>(makeErrorCode(DbError::ConstraintViolation));
+    }
+
+    const char* sql =
+    "INSERT INTO notification_outbox "
+    "(channel, task_id, description, reminder_minutes, created_at, due_date, message, attempts, next_attempt_ms, priority, "
+    "reminder_at) VALUES (?, ?, ?, ?, ?, ?, ?, 0, ?, ?, ?);";
+
+    sqlite3_stmt* stmt = nullptr;
+
+    try {
+        execute("BEGIN IMMEDIATE;");
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare outbox insert: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        if (firstAttempt == std::chrono::system_clock::time_point{}) {
+            firstAttempt = std::chrono::system_clock::now();
+        }
+        auto firstAttemptMs = std::chrono::duration_cast<std::chrono::milliseconds>(firstAttempt.time_since_epoch());
+
+        if (sqlite3_bind_text(stmt, 1, channel.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 2, task.getId()) != SQLITE_OK ||
+            sqlite3_bind_text(stmt, 3, task.getDescription().c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 4, task.getReminderMinutes()) != SQLITE_OK ||
+            sqlite3_bind_int64(stmt, 5, static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(task.getCreatedAt()))) != SQLITE_OK ||
+            sqlite3_bind_int64(stmt, 6, static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(task.getDueDate()))) != SQLITE_OK ||
+            sqlite3_bind_text(stmt, 7, message.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+            sqlite3_bind_int64(stmt, 8, static_cast<sqlite3_int64>(firstAttemptMs.count())) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 9, priority) != SQLITE_OK ||
+            sqlite3_bind_int64(stmt, 10, static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(task.getScheduledReminderTime()))) != SQLITE_OK) {
+            throw QueryException("Failed to bind outbox parameters");
+        }
+
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            throw QueryException("Failed to insert outbox entry: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        int entryId = static_cast<int>(sqlite3_last_insert_rowid(db));
+        sqlite3_finalize(stmt);
+        execute("COMMIT;");
+        return Result<int>(entryId);
+
+    } catch (const DatabaseException& e) {
+        sqlite3_finalize(stmt);
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return make_unexpected<int>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<std::vector<OutboxEntry>> Database::getDueOutboxEntries(std::chrono::system_clock::time_point now, int limit) {
+    if (!isConnected()) {
+        return make_unexpected<std::vector<OutboxEntry>>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    try {
+        // Task columns come first so taskFromStatement can read them
+        const char* sql =
+        "SELECT task_id, description, reminder_minutes, created_at, due_date, 0, "
+        "id, channel, message, attempts, next_attempt_ms, priority, reminder_at "
+        "FROM notification_outbox WHERE next_attempt_ms <= ? "
+        "ORDER BY priority, next_attempt_ms, id LIMIT ?;";
+
+        sqlite3_stmt* stmt;
+        std::vector<OutboxEntry> entries;
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare outbox query: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
+        if (sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(nowMs.count())) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 2, limit) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            throw QueryException("Failed to bind outbox query parameters");
+        }
+
+        int result;
+
+        while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+            const char* channel = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 7));
+            const char* message = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 8));
+
+            // Keeps the idempotency key of the reminder the entry was queued for
+            Task task = taskFromStatement(stmt);
+            if (sqlite3_int64 reminderAt = sqlite3_column_int64(stmt, 12)) {
+                task.setScheduledReminderTime(std::chrono::system_clock::from_time_t(static_cast<std::time_t>(reminderAt)));
+            }
+
+            entries.push_back(OutboxEntry{
+                sqlite3_column_int(stmt, 6),
+                channel ? channel : "",
+                task,
+                message ? message : "",
+                sqlite3_column_int(stmt, 9),
+                std::chrono::system_clock::time_point(std::chrono::milliseconds(sqlite3_column_int64(stmt, 10))),
+                sqlite3_column_int(stmt, 11)
+            });
+        }
+
+        sqlite3_finalize(stmt);
+
+        if (result != SQLITE_DONE) {
+            throw QueryException("Error while fetching outbox entries: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        return Result<std::vector<OutboxEntry>>(entries);
+
+    } catch (const DatabaseException& e) {
+        return make_unexpected<std::vector<OutboxEntry>>(makeErrorCode(DbError::QueryFailed));
+    } catch (const TaskException& e) {
+        return make_unexpected<std::vector<OutboxEntry>>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<bool> Database::deleteOutboxEntry(int entryId) {
+    if (!isConnected()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    try {
+        const char* sql = "DELETE FROM notification_outbox WHERE id = ?;";
+
+        sqlite3_stmt* stmt;
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare outbox delete: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        if (sqlite3_bind_int(stmt, 1, entryId) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            throw QueryException("Failed to bind outbox entry ID");
+        }
+
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+
+        if (result != SQLITE_DONE) {
+            throw QueryException("Failed to delete outbox entry: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        return Result<bool>(sqlite3_changes(db) > 0);
+
+    } catch (const DatabaseException& e) {
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<bool> Database::rescheduleOutboxEntry(int entryId, int attempts,
+                                             std::chrono::system_clock::time_point nextAttempt,
+                                             const std::string& lastError) {
+    if (!isConnected()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    try {
+        const char* sql =
+            "UPDATE notification_outbox SET attempts = ?, next_attempt_ms = ?, last_error = ? WHERE id = ?;";
+
+        sqlite3_stmt* stmt;
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare outbox update: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        auto nextMs = std::chrono::duration_cast<std::chrono::milliseconds>(nextAttempt.time_since_epoch());
+        if (sqlite3_bind_int(stmt, 1, attempts) != SQLITE_OK ||
+            sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(nextMs.count())) != SQLITE_OK ||
+            sqlite3_bind_text(stmt, 3, lastError.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 4, entryId) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            throw QueryException("Failed to bind outbox update parameters");
+        }
+
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+
+        if (result != SQLITE_DONE) {
+            throw QueryException("Failed to update outbox entry: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        return Result<bool>(sqlite3_changes(db) > 0);
+
+    } catch (const DatabaseException& e) {
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<int> Database::getOutboxCount() {
+    if (!isConnected()) {
+        return make_unexpected<int>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM notification_outbox;", -1, &stmt, nullptr) != SQLITE_OK) {
+        return make_unexpected<int>(makeErrorCode(DbError::QueryFailed));
+    }
+
+    int count = 0;
+    int result = sqlite3_step(stmt);
+    if (result == SQLITE_ROW) {
+        count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+
+    if (result != SQLITE_ROW) {
+        return make_unexpected<int>(makeErrorCode(DbError::QueryFailed));
+    }
+    return Result<int>(count);
+}
+
+Result<std::map<int, int>> Database::getOutboxCountsByPriority() {
+    if (!isConnected()) {
+        return make_unexpected<std::map<int, int>>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    sqlite3_stmt* stmt;
+    const char* sql = "SELECT priority, COUNT(*) FROM notification_outbox GROUP BY priority;";
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        return make_unexpected<std::map<int, int>>(makeErrorCode(DbError::QueryFailed));
+    }
+
+    std::map<int, int> counts;
+    int result;
+    while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+        counts[sqlite3_column_int(stmt, 0)] = sqlite3_column_int(stmt, 1);
+    }
+    sqlite3_finalize(stmt);
+
+    if (result != SQLITE_DONE) {
+        return make_unexpected<std::map<int, int>>(makeErrorCode(DbError::QueryFailed));
+    }
+    return Result<std::map<int, int>>(counts);
+}
+
+void Database::addColumnIfMissing(const std::string& table, const std::string& column, const std::string& definition) {
+    sqlite3_stmt* stmt;
+    std::string sql = "PRAGMA table_info(" + table + ");";
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        throw QueryException("Failed to check " + table + " table schema");
+    }
+
+    bool found = false;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        if (name && column == name) {
+            found = true;
+            break;
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    if (!found) {
+        execute("ALTER TABLE " + table + " ADD COLUMN " + column + " " + definition + ";");
+    }
+}
+
 bool Database::execute(const std::string& sql) {
     if (!isConnected()) {
         throw ConnectionException("Database connection not established");
@@ -437,6 +830,185 @@ bool Database::execute(const std::string& sql) {
     return true;
 }
 
+Result<bool> Database::saveScheduledNotification(int taskId, std::chrono::system_clock::time_point triggerTime,
+                                                 const std::string& channels, int priority) {
+    if (!isConnected()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    if (taskId <= 0 || channels.empty()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConstraintViolation));
+    }
+
+    try {
+        const char* sql =
+        "INSERT OR REPLACE INTO scheduled_notifications (task_id, trigger_at, channels, priority) VALUES (?, ?, ?, ?);";
+
+        sqlite3_stmt* stmt;
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare schedule insert: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        if (sqlite3_bind_int(stmt, 1, taskId) != SQLITE_OK ||
+            sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(triggerTime))) != SQLITE_OK ||
+            sqlite3_bind_text(stmt, 3, channels.c_str(), -1, SQLITE_TRANSIENT) != SQLITE_OK ||
+            sqlite3_bind_int(stmt, 4, priority) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            throw QueryException("Failed to bind schedule parameters");
+        }
+
+        int result = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+
+        if (result != SQLITE_DONE) {
+            throw QueryException("Failed to save scheduled notification: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        return Result<bool>(true);
+
+    } catch (const DatabaseException& e) {
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<std::vector<ScheduledNotification>> Database::getUnfiredNotifications() {
+    if (!isConnected()) {
+        return make_unexpected<std::vector<ScheduledNotification>>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    try {
+        // Reminders of deleted or completed tasks are not re-armed
+        const char* sql =
+        "SELECT t.id, t.description, t.reminder_minutes, t.created_at, t.due_date, t.completed, "
+        "s.channels, s.trigger_at, s.priority "
+        "FROM scheduled_notifications s JOIN tasks t ON t.id = s.task_id "
+        "WHERE t.completed = 0 AND NOT EXISTS ("
+        "SELECT 1 FROM fire_ledger f WHERE f.task_id = s.task_id AND f.trigger_at = s.trigger_at) "
+        "ORDER BY s.trigger_at;";
+
+        sqlite3_stmt* stmt;
+        std::vector<ScheduledNotification> scheduled;
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare schedule query: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        int result;
+
+        while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+            const char* channels = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
+
+            scheduled.push_back(ScheduledNotification{
+                taskFromStatement(stmt),
+                channels ? channels : "",
+                std::chrono::system_clock::from_time_t(sqlite3_column_int64(stmt, 7)),
+                sqlite3_column_int(stmt, 8)
+            });
+        }
+
+        sqlite3_finalize(stmt);
+
+        if (result != SQLITE_DONE) {
+            throw QueryException("Error while fetching scheduled notifications: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        return Result<std::vector<ScheduledNotification>>(scheduled);
+
+    } catch (const DatabaseException& e) {
+        return make_unexpected<std::vector<ScheduledNotification>>(makeErrorCode(DbError::QueryFailed));
+    } catch (const TaskException& e) {
+        return make_unexpected<std::vector<ScheduledNotification>>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<bool> Database::recordFiredReminders(const std::vector<FiredReminder>& fired) {
+    if (!isConnected()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    if (fired.empty()) {
+        return Result<bool>(true);
+    }
+
+    // The whole batch is one transaction: ledger rows in, schedule rows out
+    const char* insertSql =
+    "INSERT OR IGNORE INTO fire_ledger (task_id, trigger_at, fired_at) VALUES (?, ?, ?);";
+    const char* deleteSql =
+    "DELETE FROM scheduled_notifications WHERE task_id = ? AND trigger_at = ?;";
+
+    sqlite3_stmt* insertStmt = nullptr;
+    sqlite3_stmt* deleteStmt = nullptr;
+
+    try {
+        execute("BEGIN IMMEDIATE;");
+
+        if (sqlite3_prepare_v2(db, insertSql, -1, &insertStmt, nullptr) != SQLITE_OK ||
+            sqlite3_prepare_v2(db, deleteSql, -1, &deleteStmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare fire ledger statements: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        auto firedAt = static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+
+        for (const auto& reminder : fired) {
+            auto triggerAt = static_cast<sqlite3_int64>(std::chrono::system_clock::to_time_t(reminder.triggerTime));
+
+            if (sqlite3_bind_int(insertStmt, 1, reminder.taskId) != SQLITE_OK ||
+                sqlite3_bind_int64(insertStmt, 2, triggerAt) != SQLITE_OK ||
+                sqlite3_bind_int64(insertStmt, 3, firedAt) != SQLITE_OK ||
+                sqlite3_bind_int(deleteStmt, 1, reminder.taskId) != SQLITE_OK ||
+                sqlite3_bind_int64(deleteStmt, 2, triggerAt) != SQLITE_OK) {
+                throw QueryException("Failed to bind fire ledger parameters");
+            }
+
+            if (sqlite3_step(insertStmt) != SQLITE_DONE || sqlite3_step(deleteStmt) != SQLITE_DONE) {
+                throw QueryException("Failed to record fired reminder: " + std::string(sqlite3_errmsg(db)));
+            }
+
+            sqlite3_reset(insertStmt);
+            sqlite3_reset(deleteStmt);
+        }
+
+        sqlite3_finalize(insertStmt);
+        sqlite3_finalize(deleteStmt);
+        execute("COMMIT;");
+        return Result<bool>(true);
+
+    } catch (const DatabaseException& e) {
+        sqlite3_finalize(insertStmt);
+        sqlite3_finalize(deleteStmt);
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<int> Database::getFiredCount() {
+    if (!isConnected()) {
+        return make_unexpected<int>(makeErrorCode(DbError::ConnectionFailed));
+    }
+
+    try {
+        const char* sql = "SELECT COUNT(*) FROM fire_ledger;";
+
+        sqlite3_stmt* stmt;
+
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+            throw QueryException("Failed to prepare fire ledger count: " + std::string(sqlite3_errmsg(db)));
+        }
+
+        int count = 0;
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            count = sqlite3_column_int(stmt, 0);
+        }
+        sqlite3_finalize(stmt);
+
+        return Result<int>(count);
+
+    } catch (const DatabaseException& e) {
+        return make_unexpected<int>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
 Task Database::taskFromStatement(sqlite3_stmt* stmt) {
     try {
         int id = sqlite3_column_int(stmt, 0);
@@ -468,6 +1040,59 @@ Task Database::taskFromStatement(sqlite3_stmt* stmt) {
     }
 }
 
+Result<bool> Database::beginTransaction() {
+    if (!isConnected()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    }
+    if (inTransaction()) {
+        return Result<bool>(false);
+    }
+
+    try {
+        execute("BEGIN IMMEDIATE;");
+        return Result<bool>(true);
+    } catch (const ConnectionException& e) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    } catch (const DatabaseException& e) {
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<bool> Database::commitTransaction() {
+    if (!isConnected()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    }
+    if (!inTransaction()) {
+        return Result<bool>(false);
+    }
+
+    try {
+        execute("COMMIT;");
+        return Result<bool>(true);
+    } catch (const DatabaseException& e) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
+}
+
+Result<bool> Database::rollbackTransaction() {
+    if (!isConnected()) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConnectionFailed));
+    }
+    if (!inTransaction()) {
+        return Result<bool>(false);
+    }
+
+    if (sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
+    }
+    return Result<bool>(true);
+}
+
+bool Database::inTransaction() const {
+    return db != nullptr && sqlite3_get_autocommit(db) == 0;
+}
+
 bool Database::isConnected() {
     return db != nullptr;
 }
@@ -0,0 +1,172 @@
+#include "../include/notifications/DeferredDelivery.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <algorithm>
+#include <vector>
+
+DeferredDelivery::DeferredDelivery(std::shared_ptr<Scheduler> scheduler, Submit submit)
+    : scheduler(std::move(scheduler)), submit(std::move(submit)) {
+    if (!this->scheduler || !this->submit) {
+        throw NotificationException("Deferred delivery requires a scheduler and a submit function");
+    }
+}
+
+bool DeferredDelivery::defer(const std::shared_ptr<ChannelRegistry::Channel>& channel, NotificationRequest request,
+                             Clock::time_point opensAt) {
+    if (!channel) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& backlog = backlogs[channel.get()];
+    backlog.channel = channel;
+
+    // Ordered by priority, first come first served within one
+    auto position = std::upper_bound(backlog.pending.begin(), backlog.pending.end(), request.priority,
+        [](NotificationPriority priority, const NotificationRequest& queued) {
+            return priority < queued.priority;
+        });
+    auto held = backlog.pending.insert(position, std::move(request));
+
+    if (backlog.armed || arm(backlog, opensAt)) {
+        return true;
+    }
+    // Handed back to the caller, which delivers it some other way
+    backlog.pending.erase(held);
+    return false;
+}
+
+DeferredDelivery::Clock::time_point DeferredDelivery::reserveReleaseSlot(const ChannelRegistry::Channel& channel,
+                                                                         Clock::time_point opensAt) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& reserved = slots[&channel];
+    if (reserved.opensAt != opensAt) {
+        reserved = ReleaseSlots{opensAt, 0};
+    }
+
+    auto offset = std::chrono::duration<double>(static_cast<double>(reserved.reserved++) / releaseRate);
+    return opensAt + std::chrono::duration_cast<Clock::duration>(offset);
+}
+
+bool DeferredDelivery::setReleaseRate(double perSecond) {
+    if (!(perSecond > 0.0)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    releaseRate = perSecond;
+    return true;
+}
+
+double DeferredDelivery::getReleaseRate() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return releaseRate;
+}
+
+size_t DeferredDelivery::abandon() {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t abandoned = 0;
+    for (auto& [key, backlog] : backlogs) {
+        abandoned += drop(backlog);
+    }
+    return abandoned;
+}
+
+size_t DeferredDelivery::drop(Backlog& backlog) {
+    for (auto& request : backlog.pending) {
+        if (request.receipt) {
+            request.receipt->cancel();
+        }
+    }
+    size_t dropped = backlog.pending.size();
+    backlog.pending.clear();
+    backlog.lastRelease = Clock::time_point{};
+    return dropped;
+}
+
+size_t DeferredDelivery::getBacklog(const ChannelRegistry::Channel& channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = backlogs.find(&channel);
+    return it != backlogs.end() ? it->second.pending.size() : 0;
+}
+
+DeferredDelivery::Clock::time_point DeferredDelivery::getReleaseTime(const ChannelRegistry::Channel& channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = backlogs.find(&channel);
+    return it != backlogs.end() && it->second.armed ? it->second.releaseAt : Clock::time_point{};
+}
+
+bool DeferredDelivery::arm(Backlog& backlog, Clock::time_point at) {
+    const ChannelRegistry::Channel* key = backlog.channel.get();
+    auto result = scheduler->scheduleAction(at, [this, key] { release(key); });
+    if (!result || !result.value()) {
+        return false;
+    }
+
+    backlog.armed = true;
+    backlog.releaseAt = at;
+    return true;
+}
+
+void DeferredDelivery::release(const ChannelRegistry::Channel* key) {
+    std::shared_ptr<ChannelRegistry::Channel> channel;
+    std::vector<NotificationRequest> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = backlogs.find(key);
+        if (it == backlogs.end()) {
+            return;
+        }
+        auto& backlog = it->second;
+        backlog.armed = false;
+        channel = backlog.channel;
+
+        // The window may have been changed while the backlog waited
+        auto now = Clock::now();
+        auto window = channel->getWindow();
+        if (window && !window->contains(now)) {
+            // Paced afresh from the first tick of the next opening
+            backlog.lastRelease = Clock::time_point{};
+            if (arm(backlog, window->nextOpening(now))) {
+                return;
+            }
+            // Like a reminder defer() cannot hold, it is delivered now
+            // rather than left with nothing to release it
+            batch.assign(std::make_move_iterator(backlog.pending.begin()),
+                         std::make_move_iterator(backlog.pending.end()));
+            backlog.pending.clear();
+        } else {
+            // As many as the rate allows since the last release, so a slow
+            // scheduler check releases more per tick rather than less overall
+            auto elapsed = backlog.lastRelease == Clock::time_point{} ? Clock::duration(releaseTick)
+                                                                      : now - backlog.lastRelease;
+            elapsed = std::max<Clock::duration>(elapsed, releaseTick);
+            double allowance = releaseRate * std::chrono::duration<double>(elapsed).count();
+            size_t count = std::min(backlog.pending.size(), std::max<size_t>(1, static_cast<size_t>(allowance)));
+
+            batch.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(backlog.pending.front()));
+                backlog.pending.pop_front();
+            }
+            backlog.lastRelease = now;
+        }
+    }
+
+    std::vector<NotificationRequest> retry;
+    for (auto& request : batch) {
+        if (!submit(*channel, request)) {
+            retry.push_back(std::move(request));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& backlog = backlogs[key];
+    backlog.pending.insert(backlog.pending.begin(),
+        std::make_move_iterator(retry.begin()), std::make_move_iterator(retry.end()));
+    if (backlog.pending.empty()) {
+        backlog.lastRelease = Clock::time_point{};
+    } else if (!backlog.armed && !arm(backlog, Clock::now() + releaseTick)) {
+        // Nothing left to release them; their reminders fire again on restart
+        drop(backlog);
+    }
+}
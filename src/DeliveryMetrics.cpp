@@ -0,0 +1,117 @@
+#include "../include/notifications/DeliveryMetrics.hpp"
+#include <algorithm>
+#include <bit>
+
+void DeliveryMetrics::recordAttempts(std::uint64_t count) {
+    attempts.fetch_add(count, std::memory_order_relaxed);
+}
+
+void DeliveryMetrics::recordSuccesses(std::uint64_t count, Duration latencyValue) {
+    successes.fetch_add(count, std::memory_order_relaxed);
+    latency.record(latencyValue, count);
+}
+
+void DeliveryMetrics::recordFailures(std::uint64_t count) {
+    failures.fetch_add(count, std::memory_order_relaxed);
+}
+
+void DeliveryMetrics::recordDeferred(std::uint64_t count) {
+    deferred.fetch_add(count, std::memory_order_relaxed);
+}
+
+void DeliveryMetrics::recordRejected(std::uint64_t count) {
+    rejected.fetch_add(count, std::memory_order_relaxed);
+}
+
+void DeliveryMetrics::recordQueueAge(Duration age) {
+    queueAge.record(age, 1);
+}
+
+DeliveryMetrics::Snapshot DeliveryMetrics::snapshot() const {
+    Snapshot result;
+    result.attempts = attempts.load(std::memory_order_relaxed);
+    result.successes = successes.load(std::memory_order_relaxed);
+    result.failures = failures.load(std::memory_order_relaxed);
+    result.deferred = deferred.load(std::memory_order_relaxed);
+    result.rejected = rejected.load(std::memory_order_relaxed);
+    result.latency = latency.load();
+    result.queueAge = queueAge.load();
+    return result;
+}
+
+void DeliveryMetrics::reset() {
+    attempts.store(0, std::memory_order_relaxed);
+    successes.store(0, std::memory_order_relaxed);
+    failures.store(0, std::memory_order_relaxed);
+    deferred.store(0, std::memory_order_relaxed);
+    rejected.store(0, std::memory_order_relaxed);
+    latency.reset();
+    queueAge.reset();
+}
+
+void DeliveryMetrics::AtomicHistogram::record(Duration value, std::uint64_t times) {
+    if (times == 0) {
+        return;
+    }
+
+    auto micros = static_cast<std::uint64_t>(
+        std::max<long long>(0, std::chrono::duration_cast<std::chrono::microseconds>(value).count()));
+    size_t bucket = std::min<size_t>(BucketCount - 1, std::bit_width(micros));
+
+    buckets[bucket].fetch_add(times, std::memory_order_relaxed);
+    count.fetch_add(times, std::memory_order_relaxed);
+    totalMicros.fetch_add(micros * times, std::memory_order_relaxed);
+
+    std::uint64_t seen = maxMicros.load(std::memory_order_relaxed);
+    while (micros > seen && !maxMicros.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {
+    }
+}
+
+DeliveryMetrics::Histogram DeliveryMetrics::AtomicHistogram::load() const {
+    Histogram result;
+    for (size_t i = 0; i < BucketCount; ++i) {
+        result.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    result.count = count.load(std::memory_order_relaxed);
+    result.totalMicros = totalMicros.load(std::memory_order_relaxed);
+    result.maxMicros = maxMicros.load(std::memory_order_relaxed);
+    return result;
+}
+
+void DeliveryMetrics::AtomicHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    totalMicros.store(0, std::memory_order_relaxed);
+    maxMicros.store(0, std::memory_order_relaxed);
+}
+
+double DeliveryMetrics::Histogram::averageMs() const {
+    return count > 0 ? static_cast<double>(totalMicros) / static_cast<double>(count) / 1000.0 : 0.0;
+}
+
+double DeliveryMetrics::Histogram::percentileMs(double quantile) const {
+    if (count == 0) {
+        return 0.0;
+    }
+
+    // Rank of the quantile, 1-based, then the bucket it falls in
+    auto rank = static_cast<std::uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count));
+    rank = std::max<std::uint64_t>(rank, 1);
+
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // The top bucket is open-ended; the maximum bounds it instead
+            std::uint64_t upper = i == 0 ? 0 : (i + 1 == BucketCount ? maxMicros : (std::uint64_t{1} << i));
+            return static_cast<double>(std::min(upper, maxMicros)) / 1000.0;
+        }
+    }
+    return maxMs();
+}
+
+double DeliveryMetrics::Histogram::maxMs() const {
+    return static_cast<double>(maxMicros) / 1000.0;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "../include/notifications/DeliveryWindow.hpp"
+#include "../include/core/TimeFormat.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <cstdio>
+#include <ctime>
+
+namespace {
+    constexpr int MinutesPerDay = 24 * 60;
+
+    int minuteOfDay(const std::tm& tm) {
+        return tm.tm_hour * 60 + tm.tm_min;
+    }
+}
+
+DeliveryWindow::DeliveryWindow(int openMinute, int closeMinute)
+    : openMinute(openMinute), closeMinute(closeMinute) {
+    if (openMinute < 0 || openMinute >= MinutesPerDay || closeMinute < 0 || closeMinute >= MinutesPerDay) {
+        throw NotificationException("Delivery window times must be between 00:00 and 23:59");
+    }
+    if (openMinute == closeMinute) {
+        throw NotificationException("Delivery window must not be empty");
+    }
+}
+
+std::shared_ptr<const DeliveryWindow> DeliveryWindow::parse(const std::string& text) {
+    int openHour, openMin, closeHour, closeMin;
+    char end;
+    if (std::sscanf(text.c_str(), "%d:%d-%d:%d%c", &openHour, &openMin, &closeHour, &closeMin, &end) != 4 ||
+        openHour < 0 || openHour > 23 || closeHour < 0 || closeHour > 23 ||
+        openMin < 0 || openMin > 59 || closeMin < 0 || closeMin > 59 ||
+        openHour * 60 + openMin == closeHour * 60 + closeMin) {
+        return nullptr;
+    }
+
+    return std::make_shared<const DeliveryWindow>(openHour * 60 + openMin, closeHour * 60 + closeMin);
+}
+
+bool DeliveryWindow::contains(TimePoint time) const {
+    int minute = minuteOfDay(TimeFormat::localTm(time));
+    if (openMinute < closeMinute) {
+        return minute >= openMinute && minute < closeMinute;
+    }
+    return minute >= openMinute || minute < closeMinute;
+}
+
+DeliveryWindow::TimePoint DeliveryWindow::nextOpening(TimePoint time) const {
+    if (contains(time)) {
+        return time;
+    }
+
+    // Today's opening if it is still ahead, otherwise tomorrow's; mktime
+    // normalises the day and resolves daylight saving time
+    std::tm tm = TimeFormat::localTm(time);
+    if (minuteOfDay(tm) >= openMinute) {
+        tm.tm_mday += 1;
+    }
+    tm.tm_hour = openMinute / 60;
+    tm.tm_min = openMinute % 60;
+    tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    std::time_t opening = std::mktime(&tm);
+    if (opening == -1) {
+        return time;
+    }
+    return std::chrono::system_clock::from_time_t(opening);
+}
+
+int DeliveryWindow::getOpenMinute() const noexcept {
+    return openMinute;
+}
+
+int DeliveryWindow::getCloseMinute() const noexcept {
+    return closeMinute;
+}
+
+std::string DeliveryWindow::toString() const {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%02d:%02d-%02d:%02d",
+                  openMinute / 60, openMinute % 60, closeMinute / 60, closeMinute % 60);
+    return buffer;
+}
\ No newline at end of file
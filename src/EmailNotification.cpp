@@ -1,7 +1,56 @@
 #include "../include/notifications/EmailNotification.hpp"
 #include "../include/database/Exceptions.hpp"
+#include "../include/core/TimeFormat.hpp"
+#include <curl/curl.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
-#include <regex>
+
+namespace {
+    void ensureCurlInitialized() {
+        static std::once_flag initFlag;
+        std::call_once(initFlag, [] {
+            if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+                throw EmailDeliveryException("Failed to initialize libcurl");
+            }
+        });
+    }
+
+    // Body text uses CRLF line endings on the wire
+    void appendCrlf(std::string& out, std::string_view text) {
+        size_t start = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '\n' && (i == 0 || text[i - 1] != '\r')) {
+                out.append(text, start, i - start);
+                out += "\r\n";
+                start = i + 1;
+            }
+        }
+        out.append(text, start, text.size() - start);
+    }
+
+    // Header values stay on one line whatever the template or task text contains
+    void appendHeaderValue(std::string& out, std::string_view text) {
+        for (char c : text) {
+            out += (c == '\r' || c == '\n') ? ' ' : c;
+        }
+    }
+
+    const MessageTemplate& defaultSubject() {
+        static const MessageTemplate subject("{prefix} Task Reminder");
+        return subject;
+    }
+
+    const MessageTemplate& defaultBody() {
+        static const MessageTemplate body("Task ID: {id}\nDescription: {description}\nMessage: {message}\n");
+        return body;
+    }
+
+    const MessageTemplate& defaultDigestEntry() {
+        static const MessageTemplate entry("Task ID: {id}\nDescription: {description}\nDue: {due}\nMessage: {message}\n");
+        return entry;
+    }
+}
 
 EmailNotification::EmailNotification(std::string initialRecipient) {
 
@@ -10,34 +59,761 @@ EmailNotification::EmailNotification(std::string initialRecipient) {
     } 
 }
 
+EmailNotification::~EmailNotification() {
+    disableDigest();
+    disconnect();
+}
+
 void EmailNotification::sendNotification(const Task& task, const std::string& message) {
     try {
-        // In a real implementation, this would connect to an SMTP server and send an email
-        std::cout << "Sending email to " << recipient << "\n";
-        std::cout << "Subject: " << notificationPrefix << " Task Reminder\n";
-        std::cout << "Task ID: " << task.getId() << "\n";
-        std::cout << "Description: " << task.getDescription() << "\n";
-        std::cout << "Message: " << message << "\n";
-        
-        // Simulate network issues sometimes
-        if (recipient.find("invalid") != std::string::npos) {
-            throw EmailDeliveryException("Failed to deliver email to " + recipient);
+        if (bufferDigest(NotificationRequest{task, message})) {
+            return;
+        }
+
+        Outgoing outgoing;
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            acquireRecipientTokens(recipients);
+            buildMessage(outgoing.payload, task, message);
+            prepareOutgoing(outgoing, recipientEnvelope, recipientHeader);
+        }
+
+        transmit({&outgoing});
+        if (!outgoing.error.empty()) {
+            throw EmailDeliveryException(outgoing.error);
         }
     } catch (const EmailDeliveryException& e) {
         throw; // Rethrow specific exception
+    } catch (const RateLimitedException& e) {
+        throw; // Deferred, not failed
     } catch (const std::exception& e) {
         throw EmailDeliveryException("Failed to send email notification: " + std::string(e.what()));
     }
 }
 
+void EmailNotification::sendNotificationBatch(const std::vector<NotificationRequest>& batch) {
+    bool limited;
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        limited = recipientRate > 0.0;
+    }
+
+    // Digests buffer each reminder with its outbox entry, so the entry can
+    // be acknowledged once the digest has gone out
+    // Only the entries neither buffered nor sent are reported, so the
+    // buffered ones are not delivered again
+    if (isDigestEnabled()) {
+        std::vector<size_t> failed;
+        std::vector<size_t> deferred;
+        std::string firstError;
+        std::chrono::steady_clock::time_point retryAt{};
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (!deferred.empty()) {
+                deferred.push_back(i);
+                continue;
+            }
+            try {
+                if (!bufferDigest(batch[i])) {
+                    // Digests were turned off meanwhile
+                    sendNotification(batch[i].task, batch[i].message);
+                }
+            } catch (const RateLimitedException& e) {
+                deferred.push_back(i);
+                retryAt = e.getRetryTime();
+            } catch (const NotificationException& e) {
+                failed.push_back(i);
+                if (firstError.empty()) {
+                    firstError = e.what();
+                }
+            }
+        }
+        if (failed.empty() && deferred.empty()) {
+            return;
+        }
+        std::string reason = failed.empty()
+            ? std::to_string(deferred.size()) + " of " + std::to_string(batch.size()) + " emails rate limited"
+            : std::to_string(failed.size()) + " of " + std::to_string(batch.size()) +
+                  " emails failed, first: " + firstError;
+        throw BatchDeliveryException(reason, std::move(failed), std::move(deferred), retryAt);
+    }
+
+    // Per-recipient limits may only admit part of the batch, so it goes
+    // through sendNotification one at a time
+    if (limited) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            try {
+                sendNotification(batch[i].task, batch[i].message);
+            } catch (const RateLimitedException& e) {
+                if (i == 0) {
+                    throw;
+                }
+                // The rest waits for the limiter without counting as failed
+                std::vector<size_t> deferred;
+                for (size_t j = i; j < batch.size(); ++j) {
+                    deferred.push_back(j);
+                }
+                throw BatchDeliveryException(e.what(), {}, std::move(deferred), e.getRetryTime());
+            } catch (const NotificationException& e) {
+                if (i == 0) {
+                    throw;
+                }
+                std::vector<size_t> failed;
+                for (size_t j = i; j < batch.size(); ++j) {
+                    failed.push_back(j);
+                }
+                throw BatchDeliveryException(e.what(), std::move(failed));
+            }
+        }
+        return;
+    }
+
+    std::vector<Outgoing> outgoing(batch.size());
+    std::vector<Outgoing*> messages;
+    messages.reserve(batch.size());
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            buildMessage(outgoing[i].payload, batch[i].task, batch[i].message);
+            prepareOutgoing(outgoing[i], recipientEnvelope, recipientHeader);
+            messages.push_back(&outgoing[i]);
+        }
+    }
+
+    transmit(messages);
+
+    std::vector<size_t> failed;
+    for (size_t i = 0; i < outgoing.size(); ++i) {
+        if (!outgoing[i].error.empty()) {
+            failed.push_back(i);
+        }
+    }
+    if (!failed.empty()) {
+        std::string reason = std::to_string(failed.size()) + " of " + std::to_string(batch.size()) +
+                             " emails failed, first: " + outgoing[failed.front()].error;
+        throw BatchDeliveryException(reason, std::move(failed));
+    }
+}
+
+// Caller holds sessionMutex
+void EmailNotification::prepareOutgoing(Outgoing& outgoing, std::shared_ptr<curl_slist> envelope, const std::string& to) {
+    outgoing.envelope = std::move(envelope);
+    outgoing.to = to;
+    outgoing.url = buildSmtpUrl();
+    outgoing.mailFrom = "<" + senderEmail + ">";
+    outgoing.implicitTls = smtpPort == 465;
+    outgoing.timeout = timeout;
+}
+
+// Queues every message and waits until all of them are sent or failed
+void EmailNotification::transmit(const std::vector<Outgoing*>& messages) {
+    std::unique_lock<std::mutex> lock(poolMutex);
+
+    for (Outgoing* outgoing : messages) {
+        // Back-pressure: wait for a session with room (or for a restart to finish)
+        Session* target = nullptr;
+        poolChanged.wait(lock, [&] {
+            if (stopping) {
+                return false;
+            }
+            if (sessions.empty()) {
+                startSessions();
+            }
+
+            // Least loaded session; its queue keeps messages in order
+            size_t lowest = maxQueuedPerSession;
+            for (auto& session : sessions) {
+                size_t load = session->queue.size() + (session->busy ? 1 : 0);
+                if (load < lowest) {
+                    lowest = load;
+                    target = session.get();
+                }
+            }
+            return target != nullptr;
+        });
+
+        target->queue.push_back(outgoing);
+        target->wakeup.notify_one();
+    }
+
+    poolChanged.wait(lock, [&messages] {
+        return std::all_of(messages.begin(), messages.end(), [](const Outgoing* outgoing) {
+            return outgoing->done;
+        });
+    });
+}
+
+// Caller holds poolMutex
+void EmailNotification::startSessions() {
+    ensureCurlInitialized();
+    for (size_t i = 0; i < sessionCount; ++i) {
+        sessions.push_back(std::make_unique<Session>());
+        sessions.back()->worker = std::thread(&EmailNotification::runSession, this, std::ref(*sessions.back()));
+    }
+}
+
+void EmailNotification::stopSessions() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (sessions.empty()) {
+            return;
+        }
+        stopping = true;
+        for (auto& session : sessions) {
+            session->wakeup.notify_one();
+        }
+    }
+
+    // Queued messages are sent (or time out) before the sessions close
+    for (auto& session : sessions) {
+        session->worker.join();
+    }
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    for (auto& session : sessions) {
+        if (session->handle) {
+            curl_easy_cleanup(session->handle);
+        }
+    }
+    sessions.clear();
+    stopping = false;
+    poolChanged.notify_all();
+}
+
+void EmailNotification::runSession(Session& session) {
+    std::unique_lock<std::mutex> lock(poolMutex);
+
+    while (true) {
+        session.wakeup.wait(lock, [&] { return stopping || !session.queue.empty(); });
+        if (session.queue.empty()) {
+            return;
+        }
+
+        Outgoing* outgoing = session.queue.front();
+        session.queue.pop_front();
+        session.busy = true;
+        if (inFlight++ == 0) {
+            busySince = std::chrono::steady_clock::now();
+        }
+        lock.unlock();
+
+        std::string error = sendOnSession(session, *outgoing);
+
+        lock.lock();
+        if (error.empty()) {
+            ++sentCount;
+        }
+        if (--inFlight == 0) {
+            sendTime += std::chrono::steady_clock::now() - busySince;
+        }
+        session.busy = false;
+        outgoing->error = std::move(error);
+        outgoing->done = true;
+        poolChanged.notify_all();
+    }
+}
+
+// Runs on the session's thread; returns the error, empty on success
+std::string EmailNotification::sendOnSession(Session& session, Outgoing& outgoing) {
+    if (!session.handle) {
+        session.handle = curl_easy_init();
+        if (!session.handle) {
+            return "Failed to create SMTP session";
+        }
+    }
+
+    // Options are re-applied per message; libcurl keeps the connection open
+    // between performs on the same handle, so only the envelope is resent
+    CURL* curl = session.handle;
+    curl_easy_setopt(curl, CURLOPT_URL, outgoing.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_USE_SSL, static_cast<long>(outgoing.implicitTls ? CURLUSESSL_NONE : CURLUSESSL_TRY));
+    curl_easy_setopt(curl, CURLOPT_MAIL_FROM, outgoing.mailFrom.c_str());
+    curl_easy_setopt(curl, CURLOPT_MAIL_RCPT, outgoing.envelope.get());
+    curl_easy_setopt(curl, CURLOPT_READFUNCTION, readOutgoing);
+    curl_easy_setopt(curl, CURLOPT_READDATA, &outgoing);
+    curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(outgoing.timeout.count()));
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(outgoing.timeout.count()));
+
+    CURLcode rc = curl_easy_perform(curl);
+    if (rc == CURLE_OK) {
+        return std::string();
+    }
+
+    // Drop the connection so the next message starts from a clean one
+    curl_easy_cleanup(curl);
+    session.handle = nullptr;
+    return "Failed to deliver email to " + outgoing.to + ": " + curl_easy_strerror(rc);
+}
+
+// Feeds a queued message to libcurl's upload
+size_t EmailNotification::readOutgoing(char* buffer, size_t size, size_t count, void* userData) {
+    auto* outgoing = static_cast<Outgoing*>(userData);
+    size_t chunk = std::min(size * count, outgoing->payload.size() - outgoing->offset);
+    std::memcpy(buffer, outgoing->payload.data() + outgoing->offset, chunk);
+    outgoing->offset += chunk;
+    return chunk;
+}
+
+std::string EmailNotification::buildSmtpUrl() const {
+    // Port 465 is implicit TLS; anything else upgrades with STARTTLS when offered
+    std::string scheme = smtpPort == 465 ? "smtps://" : "smtp://";
+    return scheme + smtpServer + ":" + std::to_string(smtpPort);
+}
+
+// Caller holds sessionMutex
+void EmailNotification::buildMessage(std::string& out, const Task& task, const std::string& message) {
+    auto subject = subjectTemplate();
+    auto body = bodyTemplate();
+
+    out.clear();
+    out += "Date: ";
+    TimeFormat::appendRfc2822(out, std::chrono::system_clock::now());
+    out += "\r\nTo: ";
+    out += recipientHeader;
+    out += "\r\nFrom: <";
+    out += senderEmail;
+    out += ">\r\nSubject: ";
+    renderBuffer.clear();
+    (subject ? *subject : defaultSubject()).render(renderBuffer, task, message, notificationPrefix);
+    appendHeaderValue(out, renderBuffer);
+    // A stable Message-ID lets receiving servers drop a reminder resent after a restart
+    out += "\r\nMessage-ID: <";
+    appendIdempotencyKey(out, task);
+    out += '@';
+    size_t at = senderEmail.rfind('@');
+    out.append(senderEmail, at == std::string::npos ? senderEmail.size() : at + 1);
+    if (at == std::string::npos || at + 1 == senderEmail.size()) {
+        out += "localhost";
+    }
+    out += ">\r\nMIME-Version: 1.0\r\n";
+    out += "Content-Type: text/plain; charset=UTF-8\r\n";
+    out += "\r\n";
+    renderBuffer.clear();
+    (body ? *body : defaultBody()).render(renderBuffer, task, message, notificationPrefix);
+    appendCrlf(out, renderBuffer);
+}
+
+// Caller holds sessionMutex
+void EmailNotification::buildDigestMessage(std::string& out, const std::string& to,
+                                           const std::vector<NotificationRequest>& entries) {
+    // A custom body template renders each reminder in the digest
+    auto body = bodyTemplate();
+    const MessageTemplate& entryTemplate = body ? *body : defaultDigestEntry();
+
+    out.clear();
+    out += "Date: ";
+    TimeFormat::appendRfc2822(out, std::chrono::system_clock::now());
+    out += "\r\nTo: ";
+    out += to;
+    out += "\r\nFrom: <";
+    out += senderEmail;
+    out += ">\r\nSubject: ";
+    appendHeaderValue(out, notificationPrefix);
+    out += ' ';
+    out += std::to_string(entries.size());
+    out += " Task Reminders\r\n";
+    out += "MIME-Version: 1.0\r\n";
+    out += "Content-Type: text/plain; charset=UTF-8\r\n";
+    out += "\r\n";
+    out += "You have ";
+    out += std::to_string(entries.size());
+    out += " task reminders:\r\n";
+
+    for (const auto& entry : entries) {
+        out += "\r\n";
+        renderBuffer.clear();
+        entryTemplate.render(renderBuffer, entry.task, entry.message, notificationPrefix);
+        appendCrlf(out, renderBuffer);
+    }
+}
+
+// Adds the reminder to the digest of the current recipients; false if digest
+// mode is off. Never sends: a full digest is handed to the flusher thread, so
+// a failed send cannot be reported to a caller whose reminder is buffered.
+bool EmailNotification::bufferDigest(NotificationRequest request) {
+    std::lock_guard<std::mutex> digestLock(digestMutex);
+    if (digestMaxReminders == 0) {
+        return false;
+    }
+
+    std::string to;
+    std::vector<std::string> digestRecipients;
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        to = recipientHeader;
+        digestRecipients = recipients;
+    }
+    Digest& digest = digests[to];
+    if (digest.entries.empty()) {
+        digest.opened = std::chrono::steady_clock::now();
+        digest.recipients = std::move(digestRecipients);
+    }
+
+    // An outbox entry handed over again after its hold lapsed is already here
+    if (request.outboxId != 0) {
+        for (const auto& entry : digest.entries) {
+            if (entry.outboxId == request.outboxId) {
+                return true;
+            }
+        }
+    }
+    digest.entries.push_back(std::move(request));
+
+    digestWakeup.notify_one();
+    return true;
+}
+
+void EmailNotification::sendDigest(const std::string& to, std::vector<NotificationRequest> entries,
+                                   const std::vector<std::string>& digestRecipients) {
+    try {
+        // The digest goes to the recipients it was opened for, even if the list changed since
+        curl_slist* list = nullptr;
+        for (const auto& address : digestRecipients) {
+            list = curl_slist_append(list, ("<" + address + ">").c_str());
+        }
+        std::shared_ptr<curl_slist> envelope(list, curl_slist_free_all);
+
+        Outgoing outgoing;
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            acquireRecipientTokens(digestRecipients);
+            buildDigestMessage(outgoing.payload, to, entries);
+            prepareOutgoing(outgoing, envelope, to);
+        }
+
+        transmit({&outgoing});
+        if (!outgoing.error.empty()) {
+            throw EmailDeliveryException(outgoing.error);
+        }
+    } catch (const std::exception&) {
+        // Keep the reminders for the next flush rather than losing them
+        std::lock_guard<std::mutex> digestLock(digestMutex);
+        Digest& digest = digests[to];
+        if (digest.entries.empty()) {
+            digest.opened = std::chrono::steady_clock::now();
+            digest.recipients = digestRecipients;
+        }
+        digest.entries.insert(digest.entries.begin(),
+            std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+        throw;
+    }
+
+    reportDelivered(entries);
+}
+
+// Caller holds sessionMutex; takes cost tokens for every address or none at all
+void EmailNotification::acquireRecipientTokens(const std::vector<std::string>& addresses, size_t cost) {
+    if (recipientRate <= 0.0) {
+        return;
+    }
+
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        auto& limiter = recipientLimiters[addresses[i]];
+        if (!limiter) {
+            limiter = std::make_unique<RateLimiter>(recipientRate, recipientBurst);
+        }
+
+        RateLimiter::Clock::time_point retryAt;
+        if (!limiter->tryAcquire(cost, &retryAt)) {
+            for (size_t j = 0; j < i; ++j) {
+                recipientLimiters[addresses[j]]->release(cost);
+            }
+            throw RateLimitedException("recipient " + addresses[i] + " is over its rate limit", retryAt);
+        }
+    }
+}
+
+bool EmailNotification::setRecipientRateLimit(double perSecond, size_t burst) {
+    if (!(perSecond > 0.0) || burst == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    recipientRate = perSecond;
+    recipientBurst = burst;
+    recipientLimiters.clear();
+    return true;
+}
+
+void EmailNotification::disableRecipientRateLimit() {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    recipientRate = 0.0;
+    recipientBurst = 0;
+    recipientLimiters.clear();
+}
+
+double EmailNotification::getRecipientRate() const {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    return recipientRate;
+}
+
+size_t EmailNotification::getRecipientBurst() const {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    return recipientBurst;
+}
+
+void EmailNotification::flushDigests(bool force) {
+    std::vector<std::pair<std::string, Digest>> ready;
+    {
+        std::lock_guard<std::mutex> lock(digestMutex);
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = digests.begin(); it != digests.end();) {
+            if (force || now - it->second.opened >= digestWindow ||
+                it->second.entries.size() >= digestMaxReminders) {
+                ready.emplace_back(it->first, std::move(it->second));
+                it = digests.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // A failed digest is put back by sendDigest; the others still go out
+    size_t failed = 0;
+    std::string firstError;
+    for (auto& [to, digest] : ready) {
+        if (digest.entries.empty()) {
+            continue;
+        }
+        try {
+            sendDigest(to, std::move(digest.entries), digest.recipients);
+        } catch (const std::exception& e) {
+            if (failed++ == 0) {
+                firstError = e.what();
+            }
+        }
+    }
+
+    if (failed > 0) {
+        throw EmailDeliveryException(std::to_string(failed) + " of " + std::to_string(ready.size()) +
+                                     " digests not sent, first: " + firstError);
+    }
+}
+
+void EmailNotification::runDigestFlusher() {
+    std::unique_lock<std::mutex> lock(digestMutex);
+
+    while (!stopDigest) {
+        // Sleep until the oldest open digest is due; a full one is due now
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        for (const auto& [to, digest] : digests) {
+            if (digest.entries.size() >= digestMaxReminders) {
+                deadline = std::chrono::steady_clock::now();
+            } else {
+                deadline = std::min(deadline, digest.opened + digestWindow);
+            }
+        }
+
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            digestWakeup.wait(lock);
+            continue;
+        }
+        if (digestWakeup.wait_until(lock, deadline) != std::cv_status::timeout) {
+            continue;
+        }
+
+        lock.unlock();
+        try {
+            flushDigests();
+        } catch (const std::exception& e) {
+            std::cerr << "Email digest delivery failed: " << e.what() << std::endl;
+            // Back off for a full window before retrying
+            lock.lock();
+            digestWakeup.wait_for(lock, digestWindow, [this] { return stopDigest; });
+            continue;
+        }
+        lock.lock();
+    }
+}
+
+bool EmailNotification::setDigestPolicy(const std::chrono::seconds& window, size_t maxReminders) {
+    if (window.count() <= 0 || maxReminders == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(digestMutex);
+    digestWindow = window;
+    digestMaxReminders = maxReminders;
+
+    if (!digestThread.joinable()) {
+        stopDigest = false;
+        digestThread = std::thread(&EmailNotification::runDigestFlusher, this);
+    }
+    digestWakeup.notify_one();
+    return true;
+}
+
+void EmailNotification::disableDigest() {
+    {
+        std::lock_guard<std::mutex> lock(digestMutex);
+        digestMaxReminders = 0;
+        stopDigest = true;
+    }
+    digestWakeup.notify_all();
+
+    if (digestThread.joinable()) {
+        digestThread.join();
+    }
+
+    // Whatever is still buffered goes out now; digests that fail stay
+    // buffered and are counted by getPendingDigestCount
+    try {
+        flushDigests(true);
+    } catch (const std::exception& e) {
+        std::cerr << "Email digest delivery failed: " << e.what() << std::endl;
+
+        // Outbox entries are sent again, one by one, once their hold lapses
+        std::lock_guard<std::mutex> lock(digestMutex);
+        for (auto it = digests.begin(); it != digests.end();) {
+            auto& entries = it->second.entries;
+            std::erase_if(entries, [](const NotificationRequest& entry) { return entry.outboxId != 0; });
+            it = entries.empty() ? digests.erase(it) : std::next(it);
+        }
+    }
+}
+
+std::chrono::milliseconds EmailNotification::getHoldTime() const {
+    std::lock_guard<std::mutex> lock(digestMutex);
+    if (digestMaxReminders == 0) {
+        return std::chrono::milliseconds::zero();
+    }
+    return digestWindow;
+}
+
+bool EmailNotification::isDigestEnabled() const {
+    std::lock_guard<std::mutex> lock(digestMutex);
+    return digestMaxReminders > 0;
+}
+
+std::chrono::seconds EmailNotification::getDigestWindow() const {
+    std::lock_guard<std::mutex> lock(digestMutex);
+    return digestWindow;
+}
+
+size_t EmailNotification::getDigestMaxReminders() const {
+    std::lock_guard<std::mutex> lock(digestMutex);
+    return digestMaxReminders;
+}
+
+size_t EmailNotification::getPendingDigestCount() const {
+    std::lock_guard<std::mutex> lock(digestMutex);
+    size_t pending = 0;
+    for (const auto& [to, digest] : digests) {
+        pending += digest.entries.size();
+    }
+    return pending;
+}
+
+void EmailNotification::disconnect() {
+    stopSessions();
+}
+
 bool EmailNotification::setRecipient(const std::string& newRecipient) {
-    // Simple email validation
-    std::regex emailRegex("^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}$");
-    if (!std::regex_match(newRecipient, emailRegex)) {
+    return setRecipients({newRecipient});
+}
+
+bool EmailNotification::setRecipients(const std::vector<std::string>& newRecipients) {
+    if (newRecipients.empty()) {
         return false;
     }
-    
-    recipient = newRecipient;
+
+    for (const auto& address : newRecipients) {
+        if (!isValidAddress(address)) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    recipients.clear();
+    for (const auto& address : newRecipients) {
+        if (std::find(recipients.begin(), recipients.end(), address) == recipients.end()) {
+            recipients.push_back(address);
+        }
+    }
+    rebuildRecipientCache();
+    return true;
+}
+
+bool EmailNotification::addRecipient(const std::string& address) {
+    if (!isValidAddress(address)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    if (std::find(recipients.begin(), recipients.end(), address) != recipients.end()) {
+        return false;
+    }
+    recipients.push_back(address);
+    rebuildRecipientCache();
+    return true;
+}
+
+bool EmailNotification::removeRecipient(const std::string& address) {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    auto it = std::find(recipients.begin(), recipients.end(), address);
+
+    // At least one recipient must remain
+    if (it == recipients.end() || recipients.size() == 1) {
+        return false;
+    }
+    recipients.erase(it);
+    rebuildRecipientCache();
+    return true;
+}
+
+// Caller holds sessionMutex
+void EmailNotification::rebuildRecipientCache() {
+    curl_slist* envelope = nullptr;
+    recipientHeader.clear();
+
+    for (const auto& address : recipients) {
+        envelope = curl_slist_append(envelope, ("<" + address + ">").c_str());
+        if (!recipientHeader.empty()) {
+            recipientHeader += ", ";
+        }
+        recipientHeader += "<" + address + ">";
+    }
+    recipientEnvelope.reset(envelope, curl_slist_free_all);
+}
+
+bool EmailNotification::isValidAddress(std::string_view address) {
+    auto isLetter = [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    };
+    auto isDigit = [](char c) {
+        return c >= '0' && c <= '9';
+    };
+
+    size_t at = address.find('@');
+    if (at == 0 || at == std::string_view::npos) {
+        return false;
+    }
+
+    for (char c : address.substr(0, at)) {
+        if (!isLetter(c) && !isDigit(c) && c != '.' && c != '_' && c != '%' && c != '+' && c != '-') {
+            return false;
+        }
+    }
+
+    // Domain: [a-zA-Z0-9.-]+ then a final dot and a letters-only TLD of 2+
+    std::string_view domain = address.substr(at + 1);
+    size_t dot = domain.rfind('.');
+    if (dot == std::string_view::npos || dot == 0 || domain.size() - dot - 1 < 2) {
+        return false;
+    }
+
+    for (char c : domain.substr(0, dot)) {
+        if (!isLetter(c) && !isDigit(c) && c != '.' && c != '-') {
+            return false;
+        }
+    }
+    for (char c : domain.substr(dot + 1)) {
+        if (!isLetter(c)) {
+            return false;
+        }
+    }
     return true;
 }
 
@@ -45,6 +821,8 @@ bool EmailNotification::setSmtpServer(const std::string& server) {
     if (server.empty()) {
         return false;
     }
+    disconnect();
+    std::lock_guard<std::mutex> lock(sessionMutex);
     smtpServer = server;
     return true;
 }
@@ -53,33 +831,99 @@ bool EmailNotification::setSmtpPort(int port) {
     if (port <= 0 || port > 65535) {
         return false;
     }
+    disconnect();
+    std::lock_guard<std::mutex> lock(sessionMutex);
     smtpPort = port;
     return true;
 }
 
 bool EmailNotification::setSenderEmail(const std::string& email) {
-    // Simple email validation
-    std::regex emailRegex("^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\\.[a-zA-Z]{2,}$");
-    if (!std::regex_match(email, emailRegex)) {
+    if (!isValidAddress(email)) {
         return false;
     }
     
+    std::lock_guard<std::mutex> lock(sessionMutex);
     senderEmail = email;
     return true;
 }
 
+bool EmailNotification::setTimeout(const std::chrono::milliseconds& newTimeout) {
+    if (newTimeout.count() <= 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    timeout = newTimeout;
+    return true;
+}
+
 std::string EmailNotification::getRecipient() const {
-    return recipient;
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    return recipients.empty() ? std::string() : recipients.front();
+}
+
+std::vector<std::string> EmailNotification::getRecipients() const {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    return recipients;
 }
 
 std::string EmailNotification::getSmtpServer() const {
+    std::lock_guard<std::mutex> lock(sessionMutex);
     return smtpServer;
 }
 
 int EmailNotification::getSmtpPort() const {
+    std::lock_guard<std::mutex> lock(sessionMutex);
     return smtpPort;
 }
 
 std::string EmailNotification::getSenderEmail() const {
+    std::lock_guard<std::mutex> lock(sessionMutex);
     return senderEmail;
+}
+
+std::chrono::milliseconds EmailNotification::getTimeout() const {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    return timeout;
+}
+
+bool EmailNotification::setSessionCount(size_t count) {
+    if (count == 0 || count > 64) {
+        return false;
+    }
+    disconnect();
+    std::lock_guard<std::mutex> lock(poolMutex);
+    sessionCount = count;
+    return true;
+}
+
+bool EmailNotification::setMaxQueuedPerSession(size_t count) {
+    if (count == 0) {
+        return false;
+    }
+    disconnect();
+    std::lock_guard<std::mutex> lock(poolMutex);
+    maxQueuedPerSession = count;
+    return true;
+}
+
+size_t EmailNotification::getSessionCount() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return sessionCount;
+}
+
+size_t EmailNotification::getMaxQueuedPerSession() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return maxQueuedPerSession;
+}
+
+size_t EmailNotification::getSentCount() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return sentCount;
+}
+
+// Messages per second of time with at least one message in flight
+double EmailNotification::getMessagesPerSecond() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    double seconds = std::chrono::duration<double>(sendTime).count();
+    return seconds > 0.0 ? static_cast<double>(sentCount) / seconds : 0.0;
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "../include/core/EventChecker.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <iostream>
+
+EventChecker::EventChecker(std::shared_ptr<Scheduler> checked, std::chrono::milliseconds checkInterval)
+    : scheduler(std::move(checked)), interval(checkInterval) {
+    if (!scheduler) {
+        throw SchedulerException("Event checker requires a scheduler");
+    }
+    if (interval.count() <= 0) {
+        throw SchedulerException("Event checker interval must be positive");
+    }
+}
+
+EventChecker::~EventChecker() {
+    stop();
+}
+
+void EventChecker::start() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+    if (isRunning()) {
+        return;
+    }
+
+    // A worker left by an earlier stop() is joined before it is replaced
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    running = true;
+    worker = std::thread(&EventChecker::runWorker, this);
+}
+
+void EventChecker::stop() {
+    std::lock_guard<std::mutex> lifecycle(lifecycleMutex);
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        running = false;
+    }
+    wakeup.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+std::chrono::milliseconds EventChecker::getInterval() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return interval;
+}
+
+bool EventChecker::isRunning() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return running;
+}
+
+void EventChecker::runWorker() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    while (running) {
+        lock.unlock();
+
+        try {
+            auto result = scheduler->checkAndTriggerEvents();
+            if (!result) {
+                std::cerr << "Error in background checker: " << result.error().message() << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error in background checker: " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        // Woken early only by stop()
+        wakeup.wait_for(lock, interval, [this] { return !running; });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "../include/notifications/FileNotification.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+    int openAppend(const std::string& path) {
+        return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, 0644);
+    }
+    long long writeFd(int fd, const char* data, size_t size) {
+        return _write(fd, data, static_cast<unsigned int>(size));
+    }
+    int syncFd(int fd) { return _commit(fd); }
+    int closeFd(int fd) { return _close(fd); }
+#else
+    int openAppend(const std::string& path) {
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    }
+    long long writeFd(int fd, const char* data, size_t size) {
+        return ::write(fd, data, size);
+    }
+    int syncFd(int fd) { return ::fsync(fd); }
+    int closeFd(int fd) { return ::close(fd); }
+#endif
+}
+
+FileNotification::FileNotification(std::string journalPath)
+    : path(std::move(journalPath)) {
+    if (path.empty()) {
+        throw NotificationException("Notification log path cannot be empty");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    openFile();
+    writeBuffer.reserve(bufferSize);
+    syncThread = std::thread(&FileNotification::runSyncLoop, this);
+}
+
+FileNotification::~FileNotification() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopSync = true;
+    }
+    syncWakeup.notify_all();
+    if (syncThread.joinable()) {
+        syncThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    try {
+        syncLocked();
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to flush notification log: " << e.what() << std::endl;
+    }
+    closeFile();
+}
+
+void FileNotification::sendNotification(const Task& task, const std::string& message) {
+    std::lock_guard<std::mutex> lock(mutex);
+    appendRecord(task, message);
+
+    if (unsyncedRecords >= syncEveryRecords) {
+        syncLocked();
+    }
+}
+
+void FileNotification::sendNotificationBatch(const std::vector<NotificationRequest>& batch) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& request : batch) {
+        appendRecord(request.task, request.message);
+    }
+
+    if (unsyncedRecords >= syncEveryRecords) {
+        syncLocked();
+    }
+}
+
+void FileNotification::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    syncLocked();
+}
+
+// Caller holds mutex
+void FileNotification::appendRecord(const Task& task, const std::string& message) {
+    size_t recordStart = writeBuffer.size();
+
+    writeBuffer += "{\"time\":\"";
+    appendIsoTimestamp(writeBuffer, std::chrono::system_clock::now());
+    writeBuffer += "\",\"task_id\":";
+    writeBuffer += std::to_string(task.getId());
+    writeBuffer += ",\"description\":";
+    appendJsonString(writeBuffer, task.getDescription());
+    writeBuffer += ",\"due\":\"";
+    appendIsoTimestamp(writeBuffer, task.getDueDate());
+    writeBuffer += "\",\"reminder_minutes\":";
+    writeBuffer += std::to_string(task.getReminderMinutes());
+    writeBuffer += ",\"message\":";
+    appendJsonString(writeBuffer, message);
+    writeBuffer += ",\"idempotency_key\":\"";
+    appendIdempotencyKey(writeBuffer, task);
+    writeBuffer += "\"}\n";
+
+    ++unsyncedRecords;
+
+    // Rotation happens on record boundaries, before the file would overflow
+    if (fileSize > 0 && fileSize + writeBuffer.size() > maxFileSize) {
+        std::string record = writeBuffer.substr(recordStart);
+        writeBuffer.resize(recordStart);
+        writeBuffered();
+        rotateIfNeeded(record.size());
+        writeBuffer += record;
+    }
+
+    if (writeBuffer.size() >= bufferSize) {
+        writeBuffered();
+    }
+}
+
+// Caller holds mutex
+void FileNotification::writeBuffered() {
+    const char* data = writeBuffer.data();
+    size_t remaining = writeBuffer.size();
+
+    while (remaining > 0) {
+        long long written = writeFd(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Keep what was not written so a later flush can retry it
+            writeBuffer.erase(0, writeBuffer.size() - remaining);
+            throw NotificationException("Failed to write notification log " + path + ": " + std::strerror(errno));
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+        fileSize += static_cast<std::uintmax_t>(written);
+    }
+
+    writeBuffer.clear();
+}
+
+// Caller holds mutex
+void FileNotification::syncLocked() {
+    if (!writeBuffer.empty()) {
+        writeBuffered();
+    }
+
+    if (unsyncedRecords == 0) {
+        return;
+    }
+
+    if (syncFd(fd) != 0) {
+        throw NotificationException("Failed to sync notification log " + path + ": " + std::strerror(errno));
+    }
+    unsyncedRecords = 0;
+}
+
+// Caller holds mutex; the buffer has already been written
+void FileNotification::rotateIfNeeded(size_t incoming) {
+    if (fileSize == 0 || fileSize + incoming <= maxFileSize) {
+        return;
+    }
+
+    if (syncFd(fd) != 0) {
+        throw NotificationException("Failed to sync notification log " + path + ": " + std::strerror(errno));
+    }
+    closeFile();
+
+    // path.(N-1) -> path.N, ..., path -> path.1; the oldest file is dropped
+    std::error_code ec;
+    std::filesystem::remove(path + "." + std::to_string(maxFiles), ec);
+    for (int i = maxFiles - 1; i >= 1; --i) {
+        std::string from = path + "." + std::to_string(i);
+        if (std::filesystem::exists(from, ec)) {
+            std::filesystem::rename(from, path + "." + std::to_string(i + 1), ec);
+        }
+    }
+    std::filesystem::rename(path, path + ".1", ec);
+    if (ec) {
+        std::cerr << "Failed to rotate notification log " << path << ": " << ec.message() << std::endl;
+    }
+
+    openFile();
+}
+
+// Caller holds mutex
+void FileNotification::openFile() {
+    fd = openAppend(path);
+    if (fd < 0) {
+        throw NotificationException("Cannot open notification log " + path + ": " + std::strerror(errno));
+    }
+
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    fileSize = ec ? 0 : size;
+}
+
+// Caller holds mutex
+void FileNotification::closeFile() {
+    if (fd >= 0) {
+        closeFd(fd);
+        fd = -1;
+    }
+}
+
+void FileNotification::runSyncLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopSync) {
+        syncWakeup.wait_for(lock, syncInterval, [this] { return stopSync; });
+        if (stopSync) {
+            break;
+        }
+
+        try {
+            syncLocked();
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to flush notification log: " << e.what() << std::endl;
+        }
+    }
+}
+
+bool FileNotification::setSyncPolicy(const std::chrono::milliseconds& interval, size_t everyRecords) {
+    if (interval.count() <= 0 || everyRecords == 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        syncInterval = interval;
+        syncEveryRecords = everyRecords;
+    }
+    syncWakeup.notify_all();
+    return true;
+}
+
+bool FileNotification::setRotation(std::uintmax_t newMaxFileSize, int newMaxFiles) {
+    if (newMaxFileSize == 0 || newMaxFiles <= 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    maxFileSize = newMaxFileSize;
+    maxFiles = newMaxFiles;
+    return true;
+}
+
+bool FileNotification::setBufferSize(size_t bytes) {
+    if (bytes == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    bufferSize = bytes;
+    writeBuffer.reserve(bufferSize);
+    return true;
+}
+
+std::string FileNotification::getPath() const {
+    return path;
+}
+
+std::chrono::milliseconds FileNotification::getSyncInterval() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncInterval;
+}
+
+size_t FileNotification::getSyncEveryRecords() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncEveryRecords;
+}
+
+std::uintmax_t FileNotification::getMaxFileSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxFileSize;
+}
+
+int FileNotification::getMaxFiles() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxFiles;
+}
+
+size_t FileNotification::getUnsyncedRecords() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return unsyncedRecords;
+}
\ No newline at end of file
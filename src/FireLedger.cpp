@@ -0,0 +1,136 @@
+#include "../include/core/FireLedger.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <iostream>
+
+FireLedger::FireLedger(std::shared_ptr<Database> database)
+    : db(std::move(database)) {
+    if (!db) {
+        throw SchedulerException("Fire ledger requires a database");
+    }
+}
+
+FireLedger::~FireLedger() {
+    stop();
+}
+
+void FireLedger::recordFired(int taskId, std::chrono::system_clock::time_point triggerTime) {
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pending.push_back(FiredReminder{taskId, triggerTime});
+        full = pending.size() >= maxBatch;
+    }
+
+    if (full) {
+        wakeup.notify_one();
+    }
+}
+
+bool FireLedger::flush() {
+    std::lock_guard<std::mutex> flushLock(flushMutex);
+
+    std::vector<FiredReminder> batch;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        batch.swap(pending);
+    }
+
+    if (batch.empty()) {
+        return true;
+    }
+
+    auto result = db->recordFiredReminders(batch);
+    if (!result) {
+        // Put the batch back in front of anything recorded meanwhile
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pending.insert(pending.begin(), batch.begin(), batch.end());
+        std::cerr << "Failed to write fire ledger: " << result.error().message() << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    flushed += batch.size();
+    return true;
+}
+
+void FireLedger::start() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (running) {
+        return;
+    }
+
+    running = true;
+    worker = std::thread(&FireLedger::runWorker, this);
+}
+
+void FireLedger::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (!running) {
+            return;
+        }
+        running = false;
+    }
+    wakeup.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    // Whatever fired after the last interval is written before returning
+    flush();
+}
+
+bool FireLedger::setFlushPolicy(const std::chrono::milliseconds& interval, size_t batch) {
+    if (interval.count() <= 0 || batch == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    flushInterval = interval;
+    maxBatch = batch;
+    return true;
+}
+
+size_t FireLedger::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return pending.size();
+}
+
+size_t FireLedger::getFlushedCount() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return flushed;
+}
+
+std::chrono::milliseconds FireLedger::getFlushInterval() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return flushInterval;
+}
+
+size_t FireLedger::getMaxBatch() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return maxBatch;
+}
+
+void FireLedger::runWorker() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    while (running) {
+        wakeup.wait_for(lock, flushInterval, [this] {
+            return !running || pending.size() >= maxBatch;
+        });
+
+        if (pending.empty()) {
+            continue;
+        }
+
+        lock.unlock();
+        bool written = flush();
+        lock.lock();
+
+        // A failing database is retried on the interval, not in a tight loop
+        if (!written) {
+            wakeup.wait_for(lock, flushInterval, [this] { return !running; });
+        }
+    }
+}
\ No newline at end of file
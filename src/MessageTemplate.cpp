@@ -0,0 +1,120 @@
+#include "../include/notifications/MessageTemplate.hpp"
+#include "../include/database/Exceptions.hpp"
+#include "../include/core/TimeFormat.hpp"
+#include <charconv>
+#include <chrono>
+
+namespace {
+    void appendInt(std::string& out, int value) {
+        char buffer[16];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+}
+
+MessageTemplate::MessageTemplate(std::string text)
+    : source(std::move(text)) {
+    std::string_view rest = source;
+
+    while (!rest.empty()) {
+        size_t brace = rest.find_first_of("{}");
+        if (brace == std::string_view::npos) {
+            addLiteral(rest);
+            break;
+        }
+
+        addLiteral(rest.substr(0, brace));
+
+        // Doubled braces are literal
+        if (brace + 1 < rest.size() && rest[brace + 1] == rest[brace]) {
+            addLiteral(rest.substr(brace, 1));
+            rest.remove_prefix(brace + 2);
+            continue;
+        }
+        if (rest[brace] == '}') {
+            throw TemplateException("unmatched '}' in \"" + source + "\"");
+        }
+
+        size_t close = rest.find('}', brace + 1);
+        if (close == std::string_view::npos) {
+            throw TemplateException("unterminated placeholder in \"" + source + "\"");
+        }
+
+        Field field = parseField(rest.substr(brace + 1, close - brace - 1));
+        segments.push_back(Segment{field, 0, 0});
+        rest.remove_prefix(close + 1);
+    }
+}
+
+void MessageTemplate::addLiteral(std::string_view text) {
+    if (text.empty()) {
+        return;
+    }
+
+    // Adjacent literals (e.g. around an escaped brace) share one segment
+    if (!segments.empty() && segments.back().field == Field::Literal &&
+        segments.back().offset + segments.back().length == literals.size()) {
+        segments.back().length += text.size();
+    } else {
+        segments.push_back(Segment{Field::Literal, literals.size(), text.size()});
+    }
+    literals.append(text);
+}
+
+MessageTemplate::Field MessageTemplate::parseField(std::string_view name) {
+    if (name == "id") return Field::Id;
+    if (name == "description") return Field::Description;
+    if (name == "due") return Field::Due;
+    if (name == "due_iso") return Field::DueIso;
+    if (name == "reminder") return Field::Reminder;
+    if (name == "status") return Field::Status;
+    if (name == "message") return Field::Message;
+    if (name == "prefix") return Field::Prefix;
+    if (name == "now") return Field::Now;
+    throw TemplateException("unknown placeholder {" + std::string(name) + "}");
+}
+
+void MessageTemplate::render(std::string& out, const Task& task, std::string_view message, std::string_view prefix) const {
+    for (const auto& segment : segments) {
+        switch (segment.field) {
+        case Field::Literal:
+            out.append(literals, segment.offset, segment.length);
+            break;
+        case Field::Id:
+            appendInt(out, task.getId());
+            break;
+        case Field::Description:
+            out += task.getDescription();
+            break;
+        case Field::Due:
+            TimeFormat::appendLocal(out, task.getDueDate());
+            break;
+        case Field::DueIso:
+            TimeFormat::appendIsoUtc(out, task.getDueDate());
+            break;
+        case Field::Reminder:
+            appendInt(out, task.getReminderMinutes());
+            break;
+        case Field::Status:
+            out += task.isCompleted() ? "Completed" : "Pending";
+            break;
+        case Field::Message:
+            out += message;
+            break;
+        case Field::Prefix:
+            out += prefix;
+            break;
+        case Field::Now:
+            TimeFormat::appendLocal(out, std::chrono::system_clock::now());
+            break;
+        }
+    }
+}
+
+const std::string& MessageTemplate::getSource() const noexcept {
+    return source;
+}
+
+size_t MessageTemplate::getSegmentCount() const noexcept {
+    return segments.size();
+}
\ No newline at end of file
@@ -1,5 +1,350 @@
 #include "../include/notifications/Notification.hpp"
+#include "../include/notifications/NotificationDispatcher.hpp"
 #include "../include//database/Exceptions.hpp"
+#include "../include/core/TimeFormat.hpp"
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+
+const char* priorityName(NotificationPriority priority) {
+    switch (priority) {
+        case NotificationPriority::High: return "high";
+        case NotificationPriority::Normal: return "normal";
+        case NotificationPriority::Low: return "low";
+    }
+    return "normal";
+}
+
+bool parsePriority(const std::string& name, NotificationPriority& priority) {
+    if (name == "high") {
+        priority = NotificationPriority::High;
+    } else if (name == "normal") {
+        priority = NotificationPriority::Normal;
+    } else if (name == "low") {
+        priority = NotificationPriority::Low;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+DeliveryReceipt::DeliveryReceipt(std::function<void()> onComplete)
+    : onComplete(std::move(onComplete)) {}
+
+DeliveryReceipt::~DeliveryReceipt() {
+    if (cancelled.load() || !onComplete) {
+        return;
+    }
+    try {
+        onComplete();
+    } catch (const std::exception& e) {
+        std::cerr << "Delivery receipt error: " << e.what() << std::endl;
+    }
+}
+
+void DeliveryReceipt::cancel() noexcept {
+    cancelled.store(true);
+}
+
+bool DeliveryReceipt::isCancelled() const noexcept {
+    return cancelled.load();
+}
+
+bool Notification::submitNotification(const Task& task, const std::string& message, NotificationPriority priority,
+                                      std::shared_ptr<DeliveryReceipt> receipt) {
+    NotificationDispatcher* attached = dispatcher.load();
+    if (attached) {
+        return attached->submit(*this, task, message, priority, std::move(receipt));
+    }
+
+    sendNotification(task, message);
+    return true;
+}
+
+bool Notification::isDispatched() const noexcept {
+    return dispatcher.load() != nullptr;
+}
+
+void Notification::deliverNotification(const Task& task, const std::string& message) {
+    RateLimiter::Clock::time_point retryAt;
+    if (!rateLimiter.tryAcquire(1, &retryAt)) {
+        metrics.recordDeferred(1);
+        throw RateLimitedException("delivery deferred for task #" + std::to_string(task.getId()), retryAt);
+    }
+    if (!circuitBreaker.allowRequest()) {
+        rateLimiter.release(1);
+        metrics.recordRejected(1);
+        throw CircuitOpenException("delivery skipped for task #" + std::to_string(task.getId()));
+    }
+
+    metrics.recordAttempts(1);
+    auto started = std::chrono::steady_clock::now();
+    try {
+        sendNotification(task, message);
+    } catch (const RateLimitedException&) {
+        // Limited inside the sink (e.g. per recipient); says nothing about its health
+        circuitBreaker.cancelRequest();
+        rateLimiter.release(1);
+        metrics.recordDeferred(1);
+        throw;
+    } catch (...) {
+        circuitBreaker.recordFailure();
+        metrics.recordFailures(1);
+        throw;
+    }
+    if (reportsOutcomes()) {
+        circuitBreaker.cancelRequest();
+    } else {
+        circuitBreaker.recordSuccess();
+    }
+    metrics.recordSuccesses(1, std::chrono::steady_clock::now() - started);
+}
+
+void Notification::deliverNotificationBatch(const std::vector<NotificationRequest>& batch) {
+    RateLimiter::Clock::time_point retryAt;
+    if (!rateLimiter.tryAcquire(batch.size(), &retryAt)) {
+        metrics.recordDeferred(batch.size());
+        throw RateLimitedException("delivery deferred for " + std::to_string(batch.size()) + " notifications", retryAt);
+    }
+    if (!circuitBreaker.allowRequest()) {
+        rateLimiter.release(batch.size());
+        metrics.recordRejected(batch.size());
+        throw CircuitOpenException("delivery skipped for " + std::to_string(batch.size()) + " notifications");
+    }
+
+    metrics.recordAttempts(batch.size());
+    auto started = std::chrono::steady_clock::now();
+    try {
+        sendNotificationBatch(batch);
+    } catch (const RateLimitedException&) {
+        circuitBreaker.cancelRequest();
+        rateLimiter.release(batch.size());
+        metrics.recordDeferred(batch.size());
+        throw;
+    } catch (const BatchDeliveryException& e) {
+        // Only actual failures count against the breaker; notifications the
+        // rate limit held back give their tokens back and are deferred
+        size_t failed = std::min(e.getFailedIndices().size(), batch.size());
+        size_t deferred = std::min(e.getDeferredIndices().size(), batch.size() - failed);
+        size_t delivered = batch.size() - failed - deferred;
+        if (failed > 0) {
+            circuitBreaker.recordFailure();
+        } else if (delivered == 0 || reportsOutcomes()) {
+            circuitBreaker.cancelRequest();
+        } else {
+            circuitBreaker.recordSuccess();
+        }
+        rateLimiter.release(deferred);
+        metrics.recordFailures(failed);
+        metrics.recordDeferred(deferred);
+        metrics.recordSuccesses(delivered, std::chrono::steady_clock::now() - started);
+        throw;
+    } catch (...) {
+        circuitBreaker.recordFailure();
+        metrics.recordFailures(batch.size());
+        throw;
+    }
+    if (reportsOutcomes()) {
+        circuitBreaker.cancelRequest();
+    } else {
+        circuitBreaker.recordSuccess();
+    }
+    metrics.recordSuccesses(batch.size(), std::chrono::steady_clock::now() - started);
+}
+
+// One at a time; a failed item does not stop the rest, and only the failed
+// and rate limited items are reported, so the caller never retries one that
+// went out
+void Notification::sendNotificationBatch(const std::vector<NotificationRequest>& batch) {
+    std::vector<size_t> failed;
+    std::vector<size_t> deferred;
+    std::string firstError;
+    std::chrono::steady_clock::time_point retryAt{};
+    for (size_t i = 0; i < batch.size(); ++i) {
+        try {
+            sendNotification(batch[i].task, batch[i].message);
+        } catch (const RateLimitedException& e) {
+            // Nothing attempted yet: the whole batch waits for the limiter
+            if (i == 0) {
+                throw;
+            }
+            // The items after a limited one would be limited as well; they
+            // are deferred, not failed
+            for (size_t j = i; j < batch.size(); ++j) {
+                deferred.push_back(j);
+            }
+            retryAt = e.getRetryTime();
+            break;
+        } catch (const std::exception& e) {
+            failed.push_back(i);
+            if (firstError.empty()) {
+                firstError = e.what();
+            }
+        }
+    }
+
+    if (failed.empty() && deferred.empty()) {
+        return;
+    }
+    std::string reason;
+    if (!failed.empty()) {
+        reason = std::to_string(failed.size()) + " of " + std::to_string(batch.size()) +
+                 " notifications failed, first: " + firstError;
+    }
+    if (!deferred.empty()) {
+        reason += (reason.empty() ? "" : "; ") + std::to_string(deferred.size()) + " of " +
+                  std::to_string(batch.size()) + " notifications deferred by the rate limit";
+    }
+    throw BatchDeliveryException(reason, std::move(failed), std::move(deferred), retryAt);
+}
+
+std::chrono::milliseconds Notification::getHoldTime() const {
+    return std::chrono::milliseconds::zero();
+}
+
+void Notification::setDeliveredHandler(DeliveredHandler handler) {
+    std::lock_guard<std::mutex> lock(deliveredMutex);
+    onDelivered = std::move(handler);
+}
+
+void Notification::reportDelivered(const std::vector<NotificationRequest>& delivered) {
+    std::lock_guard<std::mutex> lock(deliveredMutex);
+    if (!onDelivered) {
+        return;
+    }
+
+    try {
+        onDelivered(delivered);
+    } catch (const std::exception& e) {
+        std::cerr << "Delivered handler error: " << e.what() << std::endl;
+    }
+}
+
+bool Notification::reportsOutcomes() const {
+    return false;
+}
+
+void Notification::reportOutcome(const Task& task, const std::string& message, const std::exception* error) {
+    if (!error) {
+        circuitBreaker.recordSuccess();
+        return;
+    }
+
+    circuitBreaker.recordFailure();
+    NotificationDispatcher* attached = dispatcher.load();
+    if (!attached || !attached->reportSinkFailure(*this, task, message, *error)) {
+        std::cerr << "Notification delivery failed: " << error->what() << std::endl;
+    }
+}
+
+CircuitBreaker& Notification::getCircuitBreaker() noexcept {
+    return circuitBreaker;
+}
+
+RateLimiter& Notification::getRateLimiter() noexcept {
+    return rateLimiter;
+}
+
+DeliveryMetrics& Notification::getMetrics() noexcept {
+    return metrics;
+}
+
+void Notification::appendJsonString(std::string& out, std::string_view value) {
+    static const char hex[] = "0123456789abcdef";
+
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += "\\u00";
+                out += hex[(c >> 4) & 0xF];
+                out += hex[c & 0xF];
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+void Notification::appendIsoTimestamp(std::string& out, std::chrono::system_clock::time_point time) {
+    TimeFormat::appendIsoUtc(out, time);
+}
+
+std::string Notification::idempotencyKey(const Task& task) {
+    std::string key;
+    appendIdempotencyKey(key, task);
+    return key;
+}
+
+void Notification::appendIdempotencyKey(std::string& out, const Task& task) {
+    char buffer[64];
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        task.getScheduledReminderTime().time_since_epoch()).count();
+
+    out += "task-";
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), task.getId());
+    out.append(buffer, result.ptr);
+    out += '-';
+    result = std::to_chars(buffer, buffer + sizeof(buffer), seconds);
+    out.append(buffer, result.ptr);
+}
+
+bool Notification::setSubjectTemplate(const std::string& text) {
+    std::shared_ptr<const MessageTemplate> compiled;
+    if (!text.empty()) {
+        try {
+            compiled = std::make_shared<const MessageTemplate>(text);
+        } catch (const TemplateException&) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(templateMutex);
+    subject = std::move(compiled);
+    return true;
+}
+
+bool Notification::setBodyTemplate(const std::string& text) {
+    std::shared_ptr<const MessageTemplate> compiled;
+    if (!text.empty()) {
+        try {
+            compiled = std::make_shared<const MessageTemplate>(text);
+        } catch (const TemplateException&) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(templateMutex);
+    body = std::move(compiled);
+    return true;
+}
+
+std::string Notification::getSubjectTemplate() const {
+    std::lock_guard<std::mutex> lock(templateMutex);
+    return subject ? subject->getSource() : std::string();
+}
+
+std::string Notification::getBodyTemplate() const {
+    std::lock_guard<std::mutex> lock(templateMutex);
+    return body ? body->getSource() : std::string();
+}
+
+std::shared_ptr<const MessageTemplate> Notification::subjectTemplate() const {
+    std::lock_guard<std::mutex> lock(templateMutex);
+    return subject;
+}
+
+std::shared_ptr<const MessageTemplate> Notification::bodyTemplate() const {
+    std::lock_guard<std::mutex> lock(templateMutex);
+    return body;
+}
 
 bool Notification::setNotificationPrefix(const std::string& prefix) {
     if (prefix.empty()) {
@@ -0,0 +1,430 @@
+#include "../include/notifications/NotificationDispatcher.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace {
+    // How long a removed sink's queue may keep delivering before the rest is dropped
+    constexpr std::chrono::milliseconds RemovalDrainTimeout{2000};
+}
+
+NotificationDispatcher::NotificationDispatcher(size_t defaultQueueCapacity)
+    : defaultQueueCapacity(defaultQueueCapacity) {
+    if (defaultQueueCapacity == 0) {
+        throw NotificationException("Dispatcher queue capacity must be positive");
+    }
+}
+
+NotificationDispatcher::~NotificationDispatcher() {
+    shutdown();
+}
+
+bool NotificationDispatcher::addSink(const std::shared_ptr<Notification>& sink, size_t queueCapacity) {
+    if (!sink) {
+        return false;
+    }
+
+    NotificationDispatcher* expected = nullptr;
+    if (!sink->dispatcher.compare_exchange_strong(expected, this)) {
+        // Already attached to this or another dispatcher
+        return false;
+    }
+
+    auto queue = std::make_shared<SinkQueue>();
+    queue->sink = sink;
+    queue->capacity = queueCapacity == 0 ? defaultQueueCapacity : queueCapacity;
+
+    {
+        std::lock_guard<std::mutex> lock(sinksMutex);
+        queue->maxBatch = maxBatchSize;
+        queue->policy = lanePolicy;
+        queue->weights = laneWeights;
+        sinks[sink.get()] = queue;
+    }
+
+    queue->worker = std::thread(runDeliveryLoop, std::ref(*queue));
+    return true;
+}
+
+bool NotificationDispatcher::removeSink(const Notification& sink) {
+    std::shared_ptr<SinkQueue> queue;
+    {
+        std::lock_guard<std::mutex> lock(sinksMutex);
+        auto it = sinks.find(&sink);
+        if (it == sinks.end()) {
+            return false;
+        }
+        queue = it->second;
+        sinks.erase(it);
+    }
+
+    stopQueue(*queue, std::chrono::steady_clock::now() + RemovalDrainTimeout);
+    return true;
+}
+
+bool NotificationDispatcher::setFailureHandler(const Notification& sink, FailureHandler handler) {
+    auto queue = findQueue(sink);
+    if (!queue) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->onFailure = std::move(handler);
+    return true;
+}
+
+bool NotificationDispatcher::reportSinkFailure(const Notification& sink, const Task& task, const std::string& message,
+                                               const std::exception& error) {
+    auto queue = findQueue(sink);
+    if (!queue) {
+        return false;
+    }
+
+    FailureHandler onFailure;
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        onFailure = queue->onFailure;
+    }
+    if (!onFailure) {
+        return false;
+    }
+
+    reportFailure(onFailure, NotificationRequest{task, message}, error);
+    return true;
+}
+
+bool NotificationDispatcher::submit(const Notification& sink, const Task& task, const std::string& message,
+                                    NotificationPriority priority, std::shared_ptr<DeliveryReceipt> receipt) {
+    auto queue = findQueue(sink);
+    if (!queue) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        // Lanes are bounded separately so bulk notices cannot crowd out urgent ones
+        auto& lane = queue->lanes[static_cast<size_t>(priority)];
+        if (queue->stopping || lane.size() >= queue->capacity) {
+            ++queue->dropped;
+            return false;
+        }
+        lane.push_back(NotificationRequest{task, message, std::chrono::steady_clock::now(), priority, 0,
+                                           std::move(receipt)});
+    }
+
+    queue->wakeup.notify_one();
+    return true;
+}
+
+void NotificationDispatcher::shutdown(std::chrono::steady_clock::time_point deadline) {
+    std::map<const Notification*, std::shared_ptr<SinkQueue>> stopping;
+    {
+        std::lock_guard<std::mutex> lock(sinksMutex);
+        stopping.swap(sinks);
+    }
+
+    // Every queue is told to stop before any is joined, so they all drain
+    // against the deadline at once
+    for (auto& [sink, queue] : stopping) {
+        markStopping(*queue, deadline);
+    }
+    for (auto& [sink, queue] : stopping) {
+        stopQueue(*queue, deadline);
+    }
+}
+
+size_t NotificationDispatcher::getQueueDepth(const Notification& sink) const {
+    auto queue = findQueue(sink);
+    if (!queue) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return pendingCount(*queue);
+}
+
+size_t NotificationDispatcher::getLaneDepth(const Notification& sink, NotificationPriority priority) const {
+    auto queue = findQueue(sink);
+    if (!queue) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->lanes[static_cast<size_t>(priority)].size();
+}
+
+size_t NotificationDispatcher::getDroppedCount(const Notification& sink) const {
+    auto queue = findQueue(sink);
+    if (!queue) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->dropped;
+}
+
+std::chrono::steady_clock::duration NotificationDispatcher::getOldestQueuedAge(const Notification& sink) const {
+    auto queue = findQueue(sink);
+    if (!queue) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    std::chrono::steady_clock::duration oldest{};
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& lane : queue->lanes) {
+        if (!lane.empty()) {
+            oldest = std::max(oldest, now - lane.front().queuedAt);
+        }
+    }
+    return oldest;
+}
+
+size_t NotificationDispatcher::getDefaultQueueCapacity() const {
+    return defaultQueueCapacity;
+}
+
+bool NotificationDispatcher::setMaxBatchSize(size_t size) {
+    if (size == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    maxBatchSize = size;
+    for (auto& [sink, queue] : sinks) {
+        std::lock_guard<std::mutex> queueLock(queue->mutex);
+        queue->maxBatch = size;
+    }
+    return true;
+}
+
+size_t NotificationDispatcher::getMaxBatchSize() const {
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    return maxBatchSize;
+}
+
+void NotificationDispatcher::setLanePolicy(LanePolicy policy) {
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    lanePolicy = policy;
+    for (auto& [sink, queue] : sinks) {
+        std::lock_guard<std::mutex> queueLock(queue->mutex);
+        queue->policy = policy;
+    }
+}
+
+bool NotificationDispatcher::setLaneWeights(const LaneWeights& weights) {
+    if (std::find(weights.begin(), weights.end(), 0u) != weights.end()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    laneWeights = weights;
+    for (auto& [sink, queue] : sinks) {
+        std::lock_guard<std::mutex> queueLock(queue->mutex);
+        queue->weights = weights;
+        queue->credits.fill(0);
+    }
+    return true;
+}
+
+NotificationDispatcher::LanePolicy NotificationDispatcher::getLanePolicy() const {
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    return lanePolicy;
+}
+
+NotificationDispatcher::LaneWeights NotificationDispatcher::getLaneWeights() const {
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    return laneWeights;
+}
+
+void NotificationDispatcher::runDeliveryLoop(SinkQueue& queue) {
+    std::unique_lock<std::mutex> lock(queue.mutex);
+
+    while (true) {
+        queue.wakeup.wait(lock, [&queue] {
+            return queue.stopping || pendingCount(queue) > 0;
+        });
+
+        // Remaining deliveries are drained before the thread exits, as far
+        // as the shutdown deadline allows
+        if (pendingCount(queue) == 0) {
+            return;
+        }
+        if (queue.stopping && std::chrono::steady_clock::now() >= queue.deadline) {
+            size_t abandoned = pendingCount(queue);
+            for (auto& lane : queue.lanes) {
+                for (auto& request : lane) {
+                    if (request.receipt) {
+                        request.receipt->cancel();
+                    }
+                }
+                lane.clear();
+            }
+            queue.dropped += abandoned;
+            std::cerr << abandoned << " queued notifications dropped when the sink was stopped" << std::endl;
+            return;
+        }
+
+        // Everything that piled up while the sink was busy goes out together,
+        // up to the burst the sink's rate limit allows
+        size_t batchLimit = queue.maxBatch;
+        size_t burst = queue.sink->getRateLimiter().getBurst();
+        if (burst > 0) {
+            batchLimit = std::min(batchLimit, burst);
+        }
+
+        std::vector<NotificationRequest> batch;
+        while (batch.size() < batchLimit && pendingCount(queue) > 0) {
+            auto& lane = queue.lanes[nextLane(queue)];
+            batch.push_back(std::move(lane.front()));
+            lane.pop_front();
+        }
+        FailureHandler onFailure = queue.onFailure;
+        lock.unlock();
+        auto handedOver = std::chrono::steady_clock::now();
+        std::vector<size_t> deferredIndices;
+        std::chrono::steady_clock::time_point retryAt{};
+
+        try {
+            if (batch.size() == 1) {
+                queue.sink->deliverNotification(batch.front().task, batch.front().message);
+            } else {
+                queue.sink->deliverNotificationBatch(batch);
+            }
+        } catch (const RateLimitedException& e) {
+            // Over the sink's rate: the batch goes back to the front of its
+            // lanes and waits for tokens, even while shutting down, though
+            // not past the shutdown deadline
+            lock.lock();
+            for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+                queue.lanes[static_cast<size_t>(it->priority)].push_front(std::move(*it));
+            }
+            while (std::chrono::steady_clock::now() < std::min(e.getRetryTime(), queue.deadline)) {
+                queue.wakeup.wait_until(lock, std::min(e.getRetryTime(), queue.deadline));
+            }
+            continue;
+        } catch (const BatchDeliveryException& e) {
+            // Only the notifications that did not go out are reported
+            for (size_t index : e.getFailedIndices()) {
+                if (index < batch.size()) {
+                    reportFailure(onFailure, batch[index], e);
+                }
+            }
+            deferredIndices = e.getDeferredIndices();
+            retryAt = e.getRetryTime();
+        } catch (const std::exception& e) {
+            for (const auto& request : batch) {
+                reportFailure(onFailure, request, e);
+            }
+        }
+
+        // The rest of a batch the rate limit cut short is taken out, in
+        // order, to be put back
+        std::vector<NotificationRequest> deferred;
+        for (auto it = deferredIndices.rbegin(); it != deferredIndices.rend(); ++it) {
+            if (*it < batch.size()) {
+                deferred.insert(deferred.begin(), std::move(batch[*it]));
+                batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(*it));
+            }
+        }
+
+        // Time spent queued; notifications put back by the rate limiter are
+        // counted when they finally go out
+        for (const auto& request : batch) {
+            queue.sink->getMetrics().recordQueueAge(handedOver - request.queuedAt);
+        }
+        // Receipts complete here, outside the queue lock
+        batch.clear();
+
+        lock.lock();
+        if (!deferred.empty()) {
+            // and waits like a fully limited batch
+            for (auto it = deferred.rbegin(); it != deferred.rend(); ++it) {
+                queue.lanes[static_cast<size_t>(it->priority)].push_front(std::move(*it));
+            }
+            while (std::chrono::steady_clock::now() < std::min(retryAt, queue.deadline)) {
+                queue.wakeup.wait_until(lock, std::min(retryAt, queue.deadline));
+            }
+        }
+    }
+}
+
+size_t NotificationDispatcher::pendingCount(const SinkQueue& queue) {
+    size_t count = 0;
+    for (const auto& lane : queue.lanes) {
+        count += lane.size();
+    }
+    return count;
+}
+
+// Picks the lane the next notification comes from; at least one lane must be
+// non-empty. Weighted uses smooth weighted round robin over the lanes that
+// have work, so with weights 8/4/1 a busy high lane gets 8 of every 13 slots.
+size_t NotificationDispatcher::nextLane(SinkQueue& queue) {
+    if (queue.policy == LanePolicy::Strict) {
+        size_t lane = 0;
+        while (queue.lanes[lane].empty()) {
+            ++lane;
+        }
+        return lane;
+    }
+
+    long total = 0;
+    size_t best = NotificationPriorityCount;
+    for (size_t lane = 0; lane < NotificationPriorityCount; ++lane) {
+        if (queue.lanes[lane].empty()) {
+            // Idle lanes do not bank credit for later
+            queue.credits[lane] = 0;
+            continue;
+        }
+        queue.credits[lane] += queue.weights[lane];
+        total += queue.weights[lane];
+        if (best == NotificationPriorityCount || queue.credits[lane] > queue.credits[best]) {
+            best = lane;
+        }
+    }
+    queue.credits[best] -= total;
+    return best;
+}
+
+void NotificationDispatcher::reportFailure(const FailureHandler& onFailure, const NotificationRequest& request,
+                                           const std::exception& error) {
+    if (!onFailure) {
+        std::cerr << "Notification delivery failed: " << error.what() << std::endl;
+        return;
+    }
+
+    try {
+        onFailure(request.task, request.message, error);
+    } catch (const std::exception& handlerError) {
+        std::cerr << "Notification failure handler error: " << handlerError.what() << std::endl;
+    }
+}
+
+void NotificationDispatcher::markStopping(SinkQueue& queue, std::chrono::steady_clock::time_point deadline) {
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.stopping = true;
+        queue.deadline = std::min(queue.deadline, deadline);
+    }
+    queue.wakeup.notify_all();
+}
+
+void NotificationDispatcher::stopQueue(SinkQueue& queue, std::chrono::steady_clock::time_point deadline) {
+    markStopping(queue, deadline);
+
+    if (queue.worker.joinable()) {
+        queue.worker.join();
+    }
+    queue.sink->dispatcher.store(nullptr);
+}
+
+std::shared_ptr<NotificationDispatcher::SinkQueue> NotificationDispatcher::findQueue(const Notification& sink) const {
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    auto it = sinks.find(&sink);
+    if (it == sinks.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
@@ -0,0 +1,454 @@
+#include "../include/notifications/NotificationOutbox.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+NotificationOutbox::NotificationOutbox(std::shared_ptr<Database> database)
+    : db(std::move(database)) {
+    if (!db) {
+        throw NotificationException("Notification outbox requires a database");
+    }
+}
+
+NotificationOutbox::~NotificationOutbox() {
+    stop();
+
+    // Sinks may outlive the outbox; they must not report back to it
+    std::map<std::string, std::shared_ptr<Notification>> registered;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        registered.swap(channels);
+    }
+    for (auto& [channel, sink] : registered) {
+        sink->setDeliveredHandler(nullptr);
+    }
+}
+
+bool NotificationOutbox::registerChannel(const std::string& channel, std::shared_ptr<Notification> sink) {
+    if (channel.empty() || !sink) {
+        return false;
+    }
+
+    // Held entries are deleted once the sink reports them delivered
+    sink->setDeliveredHandler([this](const std::vector<NotificationRequest>& delivered) {
+        acknowledge(delivered);
+    });
+
+    std::shared_ptr<Notification> previous;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        previous = std::exchange(channels[channel], sink);
+        pendingWork = true;
+    }
+    // Entries the replaced sink still holds are sent again once their hold lapses
+    if (previous && previous != sink) {
+        previous->setDeliveredHandler(nullptr);
+    }
+    // Entries left over from a previous run may now be deliverable
+    wakeup.notify_one();
+    return true;
+}
+
+bool NotificationOutbox::unregisterChannel(const std::string& channel) {
+    std::shared_ptr<Notification> removed;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        auto it = channels.find(channel);
+        if (it == channels.end()) {
+            return false;
+        }
+        removed = std::move(it->second);
+        channels.erase(it);
+    }
+    removed->setDeliveredHandler(nullptr);
+    return true;
+}
+
+bool NotificationOutbox::enqueue(const std::string& channel, const Task& task, const std::string& message,
+                                 NotificationPriority priority, std::chrono::system_clock::time_point notBefore) {
+    Result<int> result;
+    {
+        std::lock_guard<std::mutex> lock(dbMutex);
+        result = db->enqueueOutboxEntry(channel, task, message, static_cast<int>(priority),
+                                        std::max(notBefore, std::chrono::system_clock::now()));
+    }
+
+    if (!result) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pendingWork = true;
+    }
+    wakeup.notify_one();
+    return true;
+}
+
+size_t NotificationOutbox::drain() {
+    // One drain at a time, or an entry could be delivered twice
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+    size_t delivered = 0;
+    size_t fetched = 0;
+    size_t failuresBefore;
+    {
+        std::lock_guard<std::mutex> lock(dbMutex);
+        failuresBefore = storeFailures;
+    }
+
+    // Every fetched entry is either deleted or pushed into the future, so
+    // reading batches until one comes back short terminates. Each batch is
+    // the most urgent due entries, so an urgent entry queued behind a bulk
+    // backlog waits for at most the batch in progress.
+    do {
+        Result<std::vector<OutboxEntry>> due;
+        {
+            std::lock_guard<std::mutex> lock(dbMutex);
+            // An entry that could be neither deleted nor rescheduled is still
+            // due and would be fetched again, so the drain ends here
+            if (storeFailures != failuresBefore) {
+                break;
+            }
+            due = db->getDueOutboxEntries(std::chrono::system_clock::now(), batchSize);
+        }
+
+        if (!due) {
+            std::cerr << "Failed to read notification outbox: " << due.error().message() << std::endl;
+            break;
+        }
+
+        fetched = due.value().size();
+        delivered += deliverBatch(due.value());
+    } while (fetched == static_cast<size_t>(batchSize) && !isStopping());
+
+    return delivered;
+}
+
+size_t NotificationOutbox::deliverBatch(const std::vector<OutboxEntry>& entries) {
+    // Entries are grouped per channel, keeping their order within a channel,
+    // so a sink that can send several at once gets them in one batch
+    std::vector<std::string> order;
+    std::map<std::string, std::vector<const OutboxEntry*>> byChannel;
+    for (const auto& entry : entries) {
+        auto& group = byChannel[entry.channel];
+        if (group.empty()) {
+            order.push_back(entry.channel);
+        }
+        group.push_back(&entry);
+    }
+
+    size_t delivered = 0;
+    for (const auto& channel : order) {
+        if (isStopping()) {
+            break;
+        }
+        delivered += deliverChannel(channel, byChannel[channel]);
+    }
+    return delivered;
+}
+
+size_t NotificationOutbox::deliverChannel(const std::string& channel, const std::vector<const OutboxEntry*>& entries) {
+    std::shared_ptr<Notification> sink;
+    FailureHandler failureHandler;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        auto it = channels.find(channel);
+        if (it != channels.end()) {
+            sink = it->second;
+        }
+        failureHandler = onFailure;
+    }
+
+    // Batches stay within the sink's rate limit burst
+    size_t groupLimit = static_cast<size_t>(batchSize);
+    if (sink && sink->getRateLimiter().getBurst() > 0) {
+        groupLimit = std::min(groupLimit, sink->getRateLimiter().getBurst());
+    }
+    // A sink that holds what it is handed gets the entry ids along, and the
+    // rows stay until it reports them sent
+    auto holdTime = sink ? sink->getHoldTime() : std::chrono::milliseconds::zero();
+
+    size_t delivered = 0;
+    for (size_t start = 0; start < entries.size(); start += groupLimit) {
+        size_t count = std::min(groupLimit, entries.size() - start);
+        std::vector<std::string> errors(count);
+        std::vector<bool> deferred(count, false);
+        bool limited = false;
+        auto retryAt = std::chrono::steady_clock::now();
+        auto limitedUntil = retryAt;
+        auto handedOver = std::chrono::system_clock::now();
+
+        if (!sink) {
+            std::fill(errors.begin(), errors.end(), "Channel '" + channel + "' is not configured");
+        } else {
+            try {
+                if (count == 1 && holdTime.count() == 0) {
+                    sink->deliverNotification(entries[start]->task, entries[start]->message);
+                } else {
+                    std::vector<NotificationRequest> batch;
+                    batch.reserve(count);
+                    for (size_t i = 0; i < count; ++i) {
+                        const auto& entry = *entries[start + i];
+                        batch.push_back(NotificationRequest{entry.task, entry.message, {},
+                                                            static_cast<NotificationPriority>(entry.priority),
+                                                            entry.id});
+                    }
+                    sink->deliverNotificationBatch(batch);
+                }
+            } catch (const RateLimitedException& e) {
+                // Not a failure: this and the channel's remaining entries wait
+                // for the limiter without using up an attempt
+                for (size_t i = start; i < entries.size(); ++i) {
+                    deferEntry(*entries[i], e.getRetryTime());
+                }
+                break;
+            } catch (const CircuitOpenException& e) {
+                // Short-circuited: no point retrying before the breaker lets probes through
+                std::fill(errors.begin(), errors.end(), e.what());
+                retryAt = sink->getCircuitBreaker().getRetryTime();
+            } catch (const BatchDeliveryException& e) {
+                for (size_t index : e.getFailedIndices()) {
+                    if (index < count) {
+                        errors[index] = e.what();
+                    }
+                }
+                for (size_t index : e.getDeferredIndices()) {
+                    if (index < count) {
+                        deferred[index] = true;
+                        limited = true;
+                    }
+                }
+                limitedUntil = e.getRetryTime();
+            } catch (const std::exception& e) {
+                std::fill(errors.begin(), errors.end(), e.what());
+            }
+        }
+
+        // Time since the entry became due, whether first enqueued or retried
+        if (sink) {
+            for (size_t i = 0; i < count; ++i) {
+                if (!deferred[i]) {
+                    auto waited = handedOver - entries[start + i]->nextAttempt;
+                    sink->getMetrics().recordQueueAge(std::max(waited, decltype(waited)::zero()));
+                }
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (deferred[i]) {
+                deferEntry(*entries[start + i], limitedUntil);
+            } else if (finishEntry(*entries[start + i], errors[i], retryAt, holdTime, failureHandler)) {
+                ++delivered;
+            }
+        }
+
+        // Part of the group was over the limit: the channel's remaining
+        // entries wait for it as well, without using up an attempt
+        if (limited) {
+            for (size_t i = start + count; i < entries.size(); ++i) {
+                deferEntry(*entries[i], limitedUntil);
+            }
+            break;
+        }
+    }
+
+    return delivered;
+}
+
+// Deletes a delivered entry or schedules its retry; true if it was delivered.
+// An entry the sink holds is pushed back past the hold instead: it is deleted
+// when the sink reports it sent, and delivered again if that never comes.
+bool NotificationOutbox::finishEntry(const OutboxEntry& entry, const std::string& error,
+                                     std::chrono::steady_clock::time_point retryAt,
+                                     std::chrono::milliseconds holdTime, const FailureHandler& failureHandler) {
+    if (error.empty() && holdTime.count() > 0) {
+        auto heldUntil = std::chrono::system_clock::now() + 2 * holdTime;
+        std::lock_guard<std::mutex> lock(dbMutex);
+        if (!db->rescheduleOutboxEntry(entry.id, entry.attempts, heldUntil, "held by sink")) {
+            std::cerr << "Failed to reschedule held outbox entry #" << entry.id << std::endl;
+            ++storeFailures;
+        }
+        return true;
+    }
+
+    if (error.empty()) {
+        auto parkUntil = std::chrono::system_clock::now() + getMaxDelay();
+        std::lock_guard<std::mutex> lock(dbMutex);
+        if (!db->deleteOutboxEntry(entry.id)) {
+            // The entry stays and will be delivered again, so sinks may see a
+            // duplicate; it is pushed back rather than re-sent by this drain
+            std::cerr << "Failed to remove delivered outbox entry #" << entry.id << std::endl;
+            if (!db->rescheduleOutboxEntry(entry.id, entry.attempts, parkUntil, "delivered, removal failed")) {
+                ++storeFailures;
+            }
+        }
+        return true;
+    }
+
+    int attempts = entry.attempts + 1;
+    auto nextAttempt = std::chrono::system_clock::now() +
+        std::max(nextBackoff(attempts),
+                 std::chrono::ceil<std::chrono::milliseconds>(retryAt - std::chrono::steady_clock::now()));
+    {
+        std::lock_guard<std::mutex> lock(dbMutex);
+        if (!db->rescheduleOutboxEntry(entry.id, attempts, nextAttempt, error)) {
+            std::cerr << "Failed to reschedule outbox entry #" << entry.id << std::endl;
+            ++storeFailures;
+        }
+    }
+
+    if (failureHandler) {
+        OutboxEntry failed = entry;
+        failed.attempts = attempts;
+        failed.nextAttempt = nextAttempt;
+        try {
+            failureHandler(failed, error);
+        } catch (const std::exception& e) {
+            std::cerr << "Outbox failure handler error: " << e.what() << std::endl;
+        }
+    }
+    return false;
+}
+
+void NotificationOutbox::deferEntry(const OutboxEntry& entry, std::chrono::steady_clock::time_point retryAt) {
+    auto nextAttempt = std::chrono::system_clock::now() +
+        std::chrono::ceil<std::chrono::milliseconds>(retryAt - std::chrono::steady_clock::now());
+
+    std::lock_guard<std::mutex> lock(dbMutex);
+    if (!db->rescheduleOutboxEntry(entry.id, entry.attempts, nextAttempt, "rate limited")) {
+        std::cerr << "Failed to reschedule outbox entry #" << entry.id << std::endl;
+        ++storeFailures;
+    }
+}
+
+void NotificationOutbox::start() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (running) {
+        return;
+    }
+    running = true;
+    stopping = false;
+    pendingWork = true;
+    worker = std::thread(&NotificationOutbox::runWorker, this);
+}
+
+void NotificationOutbox::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        running = false;
+        stopping = true;
+    }
+    wakeup.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void NotificationOutbox::runWorker() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+
+    while (running) {
+        pendingWork = false;
+        lock.unlock();
+
+        try {
+            drain();
+        } catch (const std::exception& e) {
+            std::cerr << "Error in notification outbox: " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        // Retries become due with time, so poll even without new entries
+        wakeup.wait_for(lock, pollInterval, [this] { return !running || pendingWork; });
+    }
+}
+
+void NotificationOutbox::acknowledge(const std::vector<NotificationRequest>& delivered) {
+    std::lock_guard<std::mutex> lock(dbMutex);
+    for (const auto& request : delivered) {
+        if (request.outboxId != 0 && !db->deleteOutboxEntry(request.outboxId)) {
+            // Delivered again once its hold lapses; sinks may see a duplicate
+            std::cerr << "Failed to remove delivered outbox entry #" << request.outboxId << std::endl;
+        }
+    }
+}
+
+bool NotificationOutbox::isStopping() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return stopping;
+}
+
+std::chrono::milliseconds NotificationOutbox::nextBackoff(int attempts) {
+    std::chrono::milliseconds base;
+    std::chrono::milliseconds cap;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        base = baseDelay;
+        cap = maxDelay;
+    }
+
+    // base * 2^(attempts - 1), capped, then jittered into [delay/2, delay]
+    auto delay = base;
+    for (int i = 1; i < attempts && delay < cap; ++i) {
+        delay *= 2;
+    }
+    delay = std::min(delay, cap);
+
+    std::uniform_int_distribution<long long> jitter(delay.count() / 2, delay.count());
+    return std::chrono::milliseconds(jitter(jitterEngine));
+}
+
+bool NotificationOutbox::setRetryPolicy(const std::chrono::milliseconds& newBaseDelay,
+                                        const std::chrono::milliseconds& newMaxDelay) {
+    if (newBaseDelay.count() <= 0 || newMaxDelay < newBaseDelay) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    baseDelay = newBaseDelay;
+    maxDelay = newMaxDelay;
+    return true;
+}
+
+bool NotificationOutbox::setPollInterval(const std::chrono::milliseconds& interval) {
+    if (interval.count() <= 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    pollInterval = interval;
+    return true;
+}
+
+void NotificationOutbox::setFailureHandler(FailureHandler handler) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    onFailure = std::move(handler);
+}
+
+size_t NotificationOutbox::getPendingCount() {
+    std::lock_guard<std::mutex> lock(dbMutex);
+    auto count = db->getOutboxCount();
+    return count ? static_cast<size_t>(count.value()) : 0;
+}
+
+size_t NotificationOutbox::getPendingCount(NotificationPriority priority) {
+    std::lock_guard<std::mutex> lock(dbMutex);
+    auto counts = db->getOutboxCountsByPriority();
+    if (!counts) {
+        return 0;
+    }
+    auto it = counts.value().find(static_cast<int>(priority));
+    return it != counts.value().end() ? static_cast<size_t>(it->second) : 0;
+}
+
+std::chrono::milliseconds NotificationOutbox::getBaseDelay() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return baseDelay;
+}
+
+std::chrono::milliseconds NotificationOutbox::getMaxDelay() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return maxDelay;
+}
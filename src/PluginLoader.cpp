@@ -0,0 +1,120 @@
+#include "../include/notifications/PluginLoader.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+
+using LibraryHandle = HMODULE;
+
+LibraryHandle openLibrary(const std::string& path) {
+    return LoadLibraryA(path.c_str());
+}
+
+void* findSymbol(LibraryHandle library, const char* name) {
+    return reinterpret_cast<void*>(GetProcAddress(library, name));
+}
+
+void closeLibrary(LibraryHandle library) {
+    FreeLibrary(library);
+}
+
+std::string lastLibraryError() {
+    return "error " + std::to_string(GetLastError());
+}
+
+#else
+
+using LibraryHandle = void*;
+
+LibraryHandle openLibrary(const std::string& path) {
+    // RTLD_LOCAL keeps one plugin's symbols from satisfying another's
+    return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+}
+
+void* findSymbol(LibraryHandle library, const char* name) {
+    return dlsym(library, name);
+}
+
+void closeLibrary(LibraryHandle library) {
+    dlclose(library);
+}
+
+std::string lastLibraryError() {
+    const char* error = dlerror();
+    return error ? error : "unknown error";
+}
+
+#endif
+
+}
+
+std::shared_ptr<Notification> PluginLoader::load(const std::string& path, const std::string& channel,
+                                                  const std::string& config) {
+    LibraryHandle handle = openLibrary(path);
+    if (!handle) {
+        throw NotificationException("Cannot load plugin " + path + ": " + lastLibraryError());
+    }
+    std::shared_ptr<void> library(reinterpret_cast<void*>(handle), [](void* opened) {
+        closeLibrary(reinterpret_cast<LibraryHandle>(opened));
+    });
+
+    auto abi = reinterpret_cast<NotificationPluginAbiFunction>(findSymbol(handle, NOTIFICATION_PLUGIN_ABI_SYMBOL));
+    auto create = reinterpret_cast<CreateNotificationSinkFunction>(findSymbol(handle, NOTIFICATION_PLUGIN_CREATE_SYMBOL));
+    auto destroy = reinterpret_cast<DestroyNotificationSinkFunction>(findSymbol(handle, NOTIFICATION_PLUGIN_DESTROY_SYMBOL));
+    if (!abi || !create || !destroy) {
+        throw NotificationException("Plugin " + path + " does not export the notification sink functions");
+    }
+    if (abi() != NotificationPluginAbiVersion) {
+        throw NotificationException("Plugin " + path + " was built for plugin ABI " + std::to_string(abi()) +
+                                    ", expected " + std::to_string(NotificationPluginAbiVersion));
+    }
+
+    Notification* created = create(config.c_str());
+    if (!created) {
+        throw NotificationException("Plugin " + path + " could not create a sink from '" + config + "'");
+    }
+    // The deleter holds the library, so its code outlives the sink
+    std::shared_ptr<Notification> sink(created, [destroy, library](Notification* notification) {
+        destroy(notification);
+    });
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find_if(plugins.begin(), plugins.end(),
+                           [&channel](const LoadedPlugin& plugin) { return plugin.channel == channel; });
+    if (it != plugins.end()) {
+        *it = LoadedPlugin{path, channel, sink};
+    } else {
+        plugins.push_back(LoadedPlugin{path, channel, sink});
+    }
+    return sink;
+}
+
+bool PluginLoader::unload(const std::string& channel) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find_if(plugins.begin(), plugins.end(),
+                           [&channel](const LoadedPlugin& plugin) { return plugin.channel == channel; });
+    if (it == plugins.end()) {
+        return false;
+    }
+    plugins.erase(it);
+    return true;
+}
+
+bool PluginLoader::isPluginChannel(const std::string& channel) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::any_of(plugins.begin(), plugins.end(),
+                       [&channel](const LoadedPlugin& plugin) { return plugin.channel == channel; });
+}
+
+std::vector<PluginLoader::LoadedPlugin> PluginLoader::getPlugins() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return plugins;
+}
\ No newline at end of file
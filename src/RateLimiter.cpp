@@ -0,0 +1,90 @@
+#include "../include/notifications/RateLimiter.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    std::int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            RateLimiter::Clock::now().time_since_epoch()).count();
+    }
+}
+
+RateLimiter::RateLimiter(double perSecond, size_t burst) {
+    if (!setRate(perSecond, burst)) {
+        throw NotificationException("Invalid rate limit configuration");
+    }
+}
+
+bool RateLimiter::setRate(double perSecond, size_t burst) {
+    if (!(perSecond > 0.0) || burst == 0) {
+        return false;
+    }
+
+    auto interval = std::max<std::int64_t>(1, std::llround(1e9 / perSecond));
+    emissionInterval.store(interval);
+    burstWindow.store(interval * static_cast<std::int64_t>(burst));
+    theoreticalArrival.store(0);
+    return true;
+}
+
+void RateLimiter::disable() noexcept {
+    emissionInterval.store(0);
+}
+
+bool RateLimiter::isEnabled() const noexcept {
+    return emissionInterval.load(std::memory_order_relaxed) != 0;
+}
+
+bool RateLimiter::tryAcquire(size_t cost, Clock::time_point* retryAt) noexcept {
+    std::int64_t interval = emissionInterval.load(std::memory_order_relaxed);
+    if (interval == 0) {
+        return true;
+    }
+
+    std::int64_t window = burstWindow.load(std::memory_order_relaxed);
+    std::int64_t now = nowNanos();
+    std::int64_t increment = interval * static_cast<std::int64_t>(cost);
+    std::int64_t arrival = theoreticalArrival.load(std::memory_order_relaxed);
+
+    while (true) {
+        std::int64_t start = std::max(arrival, now);
+        std::int64_t next = start + increment;
+
+        if (next - now > window && arrival > now) {
+            limited.fetch_add(1, std::memory_order_relaxed);
+            if (retryAt) {
+                // Oversized requests wait for the bucket to refill completely
+                std::int64_t passAt = increment > window ? arrival : next - window;
+                *retryAt = Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::nanoseconds(passAt)));
+            }
+            return false;
+        }
+
+        if (theoreticalArrival.compare_exchange_weak(arrival, next, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void RateLimiter::release(size_t cost) noexcept {
+    std::int64_t increment = emissionInterval.load(std::memory_order_relaxed) * static_cast<std::int64_t>(cost);
+    if (increment != 0) {
+        theoreticalArrival.fetch_sub(increment, std::memory_order_relaxed);
+    }
+}
+
+double RateLimiter::getRate() const noexcept {
+    std::int64_t interval = emissionInterval.load(std::memory_order_relaxed);
+    return interval == 0 ? 0.0 : 1e9 / static_cast<double>(interval);
+}
+
+size_t RateLimiter::getBurst() const noexcept {
+    std::int64_t interval = emissionInterval.load(std::memory_order_relaxed);
+    return interval == 0 ? 0 : static_cast<size_t>(burstWindow.load(std::memory_order_relaxed) / interval);
+}
+
+size_t RateLimiter::getLimitedCount() const noexcept {
+    return limited.load(std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -7,14 +7,6 @@ Scheduler::~Scheduler() {}
 
 Result <bool> Scheduler::scheduleTask(const Task& task, Callback callback) {
 
-    if (!callback) {
-        return make_unexpected<bool>(makeErrorCode(DbError::ConstraintViolation));
-    }
-
-    if (events.size() >= static_cast<size_t>(maxConcurrentTasks)) {
-        return make_unexpected<bool>(makeErrorCode(DbError::ConstraintViolation));
-    }
-    
     auto now = std::chrono::system_clock::now();
     auto reminderTime = task.getReminderTime();
 
@@ -22,8 +14,30 @@ Result <bool> Scheduler::scheduleTask(const Task& task, Callback callback) {
         throw TaskSchedulingException("Reminder time has already passed");
     }
 
+    return insertEvent(task, reminderTime, std::move(callback), true);
+}
+
+Result <bool> Scheduler::restoreTask(const Task& task, std::chrono::system_clock::time_point triggerTime, Callback callback) {
+    return insertEvent(task, triggerTime, std::move(callback), false);
+}
+
+Result <bool> Scheduler::insertEvent(const Task& task, std::chrono::system_clock::time_point triggerTime, Callback callback,
+                                     bool capped) {
+
+    if (!callback) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConstraintViolation));
+    }
+
+    std::lock_guard<std::mutex> lock(eventsMutex);
+
+    if (capped && events.size() >= static_cast<size_t>(maxConcurrentTasks)) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConstraintViolation));
+    }
+
     try {
-        Event event{reminderTime, callback, task};
+        Event event{triggerTime, callback, task};
+        // Callbacks see the time the reminder was armed for
+        event.task.setScheduledReminderTime(triggerTime);
 
         events.insert({event.triggerTime, event});
         return true;
@@ -32,28 +46,68 @@ Result <bool> Scheduler::scheduleTask(const Task& task, Callback callback) {
     }
 }
 
+Result <bool> Scheduler::scheduleAction(std::chrono::system_clock::time_point time, Action action) {
+    if (!action) {
+        return make_unexpected<bool>(makeErrorCode(DbError::ConstraintViolation));
+    }
+
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    actions.insert({time, std::move(action)});
+    return true;
+}
+
 Result <bool> Scheduler::checkAndTriggerEvents() {
     auto now = std::chrono::system_clock::now();
-    auto it =events.begin();
+    std::vector<Event> due;
+    std::vector<Action> dueActions;
+
+    {
+        // Detach due events so callbacks run without blocking scheduling
+        std::lock_guard<std::mutex> lock(eventsMutex);
+        auto it = events.begin();
+        while (it != events.end() && it->first <= now) {
+            due.push_back(std::move(it->second));
+            it = events.erase(it);
+        }
+        auto action = actions.begin();
+        while (action != actions.end() && action->first <= now) {
+            dueActions.push_back(std::move(action->second));
+            action = actions.erase(action);
+        }
+    }
+
+    // Actions may schedule further actions; a failed one is not retried
+    for (auto& action : dueActions) {
+        try {
+            action();
+        } catch (const std::exception& e) {
+            //log this error
+        }
+    }
+
+    auto it = due.begin();
 
     try {
 
-        while (it != events.end() && it-> first <= now) {
+        while (it != due.end()) {
             
             try {
-                it -> second.callback(it->second.task, defaultReminderMessage);
-                it = events.erase(it);
+                it->callback(it->task, defaultReminderMessage);
             } catch (const NotificationException& e) {
                 //log this error
-                it = events.erase(it);
-                continue;
             } catch (const std::exception& e) {
                 throw SchedulerException("Fialed to trigger event: " + std::string(e.what()));
             }
+            ++it;
         }
         return true;
         
     } catch (const SchedulerException& e) {
+        // Re-arm the failed event and everything after it for the next check
+        std::lock_guard<std::mutex> lock(eventsMutex);
+        for (; it != due.end(); ++it) {
+            events.insert({it->triggerTime, std::move(*it)});
+        }
         return make_unexpected<bool>(makeErrorCode(DbError::QueryFailed));
     } 
 }
@@ -65,6 +119,7 @@ Result <bool> Scheduler::cancelTask (int taskId) {
     }
 
     try {
+        std::lock_guard<std::mutex> lock(eventsMutex);
         auto it = std::find_if(events.begin(), events.end(), 
             [taskId](const auto& pair) {
                 return pair.second.task.getId() == taskId;
@@ -87,6 +142,7 @@ bool Scheduler::setMaxConcurrentTasks(int maxTasks) {
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(eventsMutex);
     if (maxTasks < static_cast<int>(events.size())) {
         return false;
     }
@@ -116,7 +172,13 @@ std::chrono::milliseconds Scheduler::getEventCheckInterval() const {
     return eventCheckInterval;
 }
 size_t Scheduler::getPendingEventsCount() const {
+    std::lock_guard<std::mutex> lock(eventsMutex);
     return events.size();
 }
 
+size_t Scheduler::getPendingActionsCount() const {
+    std::lock_guard<std::mutex> lock(eventsMutex);
+    return actions.size();
+}
+
 
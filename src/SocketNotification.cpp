@@ -0,0 +1,420 @@
+#include "../include/notifications/SocketNotification.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    void putU32(std::string& out, std::uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            out += static_cast<char>((value >> shift) & 0xFF);
+        }
+    }
+
+    void putU64(std::string& out, std::uint64_t value) {
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out += static_cast<char>((value >> shift) & 0xFF);
+        }
+    }
+
+    std::int64_t toEpochMillis(std::chrono::system_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    }
+}
+
+SocketNotification::SocketNotification(std::string socketPath)
+    : path(std::move(socketPath)) {
+    if (path.empty()) {
+        throw NotificationException("Notification socket path cannot be empty");
+    }
+
+    openListener();
+    loopThread = std::thread(&SocketNotification::runEventLoop, this);
+}
+
+SocketNotification::~SocketNotification() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeEventLoop();
+    if (loopThread.joinable()) {
+        loopThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& subscriber : subscribers) {
+        // Last chance for frames still buffered; nothing waits on slow readers
+        flushSubscriber(*subscriber);
+        closeSubscriber(*subscriber);
+    }
+    subscribers.clear();
+    closeListener();
+}
+
+void SocketNotification::sendNotification(const Task& task, const std::string& message) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        encodeFrame(task, message);
+        enqueueFrame();
+    }
+    wakeEventLoop();
+}
+
+void SocketNotification::sendNotificationBatch(const std::vector<NotificationRequest>& batch) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& request : batch) {
+            encodeFrame(request.task, request.message);
+            enqueueFrame();
+        }
+    }
+    wakeEventLoop();
+}
+
+// Caller holds mutex
+void SocketNotification::encodeFrame(const Task& task, const std::string& message) {
+    const std::string& description = task.getDescription();
+
+    frame.clear();
+    putU32(frame, 0);
+    frame += static_cast<char>(ReminderFrame);
+    putU64(frame, static_cast<std::uint64_t>(toEpochMillis(std::chrono::system_clock::now())));
+    putU32(frame, static_cast<std::uint32_t>(task.getId()));
+    putU64(frame, static_cast<std::uint64_t>(toEpochMillis(task.getDueDate())));
+    putU32(frame, static_cast<std::uint32_t>(task.getReminderMinutes()));
+    putU32(frame, static_cast<std::uint32_t>(description.size()));
+    frame += description;
+    putU32(frame, static_cast<std::uint32_t>(message.size()));
+    frame += message;
+    size_t keyStart = frame.size();
+    putU32(frame, 0);
+    appendIdempotencyKey(frame, task);
+
+    // Patch in the lengths now that they are known
+    std::string length;
+    putU32(length, static_cast<std::uint32_t>(frame.size() - keyStart - 4));
+    frame.replace(keyStart, 4, length);
+    length.clear();
+    putU32(length, static_cast<std::uint32_t>(frame.size() - 4));
+    frame.replace(0, 4, length);
+}
+
+// Caller holds mutex
+void SocketNotification::enqueueFrame() {
+    for (auto& subscriber : subscribers) {
+        if (subscriber->closing) {
+            continue;
+        }
+
+        size_t capacity = subscriber->ring.size();
+        if (frame.size() > capacity - subscriber->used) {
+            if (policy == SlowSubscriberPolicy::Disconnect) {
+                subscriber->closing = true;
+                ++disconnected;
+            } else {
+                ++subscriber->dropped;
+                ++droppedFrames;
+            }
+            continue;
+        }
+
+        // Copy in at most two pieces around the end of the ring
+        size_t tail = (subscriber->head + subscriber->used) % capacity;
+        size_t first = std::min(frame.size(), capacity - tail);
+        std::memcpy(subscriber->ring.data() + tail, frame.data(), first);
+        std::memcpy(subscriber->ring.data(), frame.data() + first, frame.size() - first);
+        subscriber->used += frame.size();
+    }
+}
+
+bool SocketNotification::setBufferSize(size_t bytes) {
+    if (bytes < 1024) {
+        return false;
+    }
+
+    // Applies to subscribers that connect afterwards
+    std::lock_guard<std::mutex> lock(mutex);
+    bufferSize = bytes;
+    return true;
+}
+
+void SocketNotification::setSlowSubscriberPolicy(SlowSubscriberPolicy newPolicy) {
+    std::lock_guard<std::mutex> lock(mutex);
+    policy = newPolicy;
+}
+
+bool SocketNotification::setMaxSubscribers(size_t count) {
+    if (count == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    maxSubscribers = count;
+    return true;
+}
+
+std::string SocketNotification::getPath() const {
+    return path;
+}
+
+size_t SocketNotification::getBufferSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bufferSize;
+}
+
+SocketNotification::SlowSubscriberPolicy SocketNotification::getSlowSubscriberPolicy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return policy;
+}
+
+size_t SocketNotification::getMaxSubscribers() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxSubscribers;
+}
+
+size_t SocketNotification::getSubscriberCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<size_t>(std::count_if(subscribers.begin(), subscribers.end(),
+                                             [](const auto& subscriber) { return !subscriber->closing; }));
+}
+
+size_t SocketNotification::getDroppedFrames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return droppedFrames;
+}
+
+size_t SocketNotification::getDisconnectedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return disconnected;
+}
+
+const char* SocketNotification::policyName(SlowSubscriberPolicy policy) {
+    switch (policy) {
+        case SlowSubscriberPolicy::DropFrame: return "drop";
+        case SlowSubscriberPolicy::Disconnect: return "disconnect";
+    }
+    return "unknown";
+}
+
+#ifdef _WIN32
+
+void SocketNotification::openListener() {
+    throw NotificationException("Unix domain socket notifications are not supported on Windows");
+}
+
+void SocketNotification::closeListener() {}
+void SocketNotification::wakeEventLoop() {}
+void SocketNotification::runEventLoop() {}
+void SocketNotification::acceptSubscribers() {}
+bool SocketNotification::flushSubscriber(Subscriber&) { return false; }
+void SocketNotification::closeSubscriber(Subscriber&) {}
+
+#else
+
+void SocketNotification::openListener() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw NotificationException("Notification socket path is too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // A socket file left behind by an earlier run is replaced, a live one is not
+    struct stat info;
+    if (::lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            throw NotificationException("Notification socket path exists and is not a socket: " + path);
+        }
+        int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool inUse = probe >= 0 &&
+                     ::connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0) {
+            ::close(probe);
+        }
+        if (inUse) {
+            throw NotificationException("Notification socket is already in use: " + path);
+        }
+        ::unlink(path.c_str());
+    }
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw NotificationException("Failed to create notification socket: " + std::string(std::strerror(errno)));
+    }
+
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, 16) != 0 ||
+        ::pipe2(wakeFds, O_NONBLOCK | O_CLOEXEC) != 0) {
+        std::string error = std::strerror(errno);
+        closeListener();
+        throw NotificationException("Failed to listen on " + path + ": " + error);
+    }
+}
+
+void SocketNotification::closeListener() {
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(path.c_str());
+        listenFd = -1;
+    }
+    for (int& fd : wakeFds) {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void SocketNotification::wakeEventLoop() {
+    // A full pipe already guarantees a wakeup, so EAGAIN is fine
+    char byte = 0;
+    if (::write(wakeFds[1], &byte, 1) < 0 && errno != EAGAIN) {
+        std::cerr << "Failed to wake notification socket loop: " << std::strerror(errno) << std::endl;
+    }
+}
+
+void SocketNotification::runEventLoop() {
+    std::vector<pollfd> fds;
+    std::vector<Subscriber*> polled;
+
+    while (true) {
+        fds.clear();
+        polled.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return;
+            }
+
+            fds.push_back({wakeFds[0], POLLIN, 0});
+            fds.push_back({listenFd, POLLIN, 0});
+            for (auto& subscriber : subscribers) {
+                // Subscribers never send anything; POLLIN reports them hanging up
+                short events = POLLIN;
+                if (subscriber->used > 0) {
+                    events |= POLLOUT;
+                }
+                fds.push_back({subscriber->fd, events, 0});
+                polled.push_back(subscriber.get());
+            }
+        }
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Notification socket poll failed: " << std::strerror(errno) << std::endl;
+            return;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            while (::read(wakeFds[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fds[1].revents & POLLIN) {
+            acceptSubscribers();
+        }
+
+        for (size_t i = 0; i < polled.size(); ++i) {
+            Subscriber& subscriber = *polled[i];
+            short revents = fds[i + 2].revents;
+
+            if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                subscriber.closing = true;
+            } else if (revents & POLLIN) {
+                char discard[256];
+                ssize_t n = ::recv(subscriber.fd, discard, sizeof(discard), MSG_DONTWAIT);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    subscriber.closing = true;
+                }
+            }
+
+            if (!subscriber.closing && subscriber.used > 0) {
+                flushSubscriber(subscriber);
+            }
+        }
+
+        // Only this thread removes subscribers, so the pointers above stay valid
+        auto closed = std::remove_if(subscribers.begin(), subscribers.end(), [this](auto& subscriber) {
+            if (subscriber->closing) {
+                closeSubscriber(*subscriber);
+                return true;
+            }
+            return false;
+        });
+        subscribers.erase(closed, subscribers.end());
+    }
+}
+
+// Caller holds mutex
+void SocketNotification::acceptSubscribers() {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "Failed to accept notification subscriber: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        if (subscribers.size() >= maxSubscribers) {
+            ::close(fd);
+            continue;
+        }
+
+        auto subscriber = std::make_unique<Subscriber>();
+        subscriber->fd = fd;
+        subscriber->ring.resize(bufferSize);
+        subscribers.push_back(std::move(subscriber));
+    }
+}
+
+// Caller holds mutex; writes as much as the socket takes without blocking
+bool SocketNotification::flushSubscriber(Subscriber& subscriber) {
+    size_t capacity = subscriber.ring.size();
+
+    while (subscriber.used > 0) {
+        size_t contiguous = std::min(subscriber.used, capacity - subscriber.head);
+        ssize_t written = ::send(subscriber.fd, subscriber.ring.data() + subscriber.head, contiguous,
+                                 MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                subscriber.closing = true;
+            }
+            return false;
+        }
+
+        subscriber.head = (subscriber.head + static_cast<size_t>(written)) % capacity;
+        subscriber.used -= static_cast<size_t>(written);
+    }
+
+    subscriber.head = 0;
+    return true;
+}
+
+void SocketNotification::closeSubscriber(Subscriber& subscriber) {
+    if (subscriber.fd >= 0) {
+        ::close(subscriber.fd);
+        subscriber.fd = -1;
+    }
+}
+
+#endif
\ No newline at end of file
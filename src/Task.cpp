@@ -34,7 +34,7 @@ int Task::getId() const {
     return id;
 }
 
-string Task::getDescription() const {
+const string& Task::getDescription() const {
     return description;
 }
 
@@ -62,6 +62,14 @@ std::chrono::system_clock::time_point Task::getReminderTime() const {
     return dueDate - std::chrono::minutes(reminderMinutes);
 }
 
+std::chrono::system_clock::time_point Task::getScheduledReminderTime() const {
+    return scheduledReminder != std::chrono::system_clock::time_point{} ? scheduledReminder : getReminderTime();
+}
+
+void Task::setScheduledReminderTime(const std::chrono::system_clock::time_point& time) {
+    scheduledReminder = time;
+}
+
 int Task::getReminderMinutes() const {
     return reminderMinutes;
 }
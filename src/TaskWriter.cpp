@@ -0,0 +1,156 @@
+#include "../include/core/TaskWriter.hpp"
+#include "../include/core/TimeFormat.hpp"
+#include "../include/notifications/Notification.hpp"
+#include <chrono>
+
+namespace {
+    constexpr size_t IdWidth = 8;
+    constexpr size_t StatusWidth = 11;
+    constexpr size_t DueWidth = 18;
+    constexpr size_t ReminderWidth = 10;
+
+    TimeFormat::TimePoint fromSeconds(std::int64_t seconds) {
+        return TimeFormat::TimePoint(std::chrono::seconds(seconds));
+    }
+
+    // Left-aligns text in a column, with at least one space after it
+    void appendColumn(std::string& out, std::string_view text, size_t width) {
+        out += text;
+        out.append(text.size() < width ? width - text.size() : 1, ' ');
+    }
+
+    void appendCsvField(std::string& out, std::string_view value) {
+        if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+            out += value;
+            return;
+        }
+        out += '"';
+        for (char c : value) {
+            if (c == '"') {
+                out += '"';
+            }
+            out += c;
+        }
+        out += '"';
+    }
+}
+
+bool TaskWriter::parseFormat(const std::string& name, Format& format) {
+    if (name == "table") {
+        format = Format::Table;
+    } else if (name == "csv") {
+        format = Format::Csv;
+    } else if (name == "json") {
+        format = Format::Json;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+TaskWriter::TaskWriter(std::ostream& out, Format format)
+    : out(out), format(format) {
+    buffer.reserve(FlushThreshold + 1024);
+    writeHeader();
+}
+
+TaskWriter::~TaskWriter() {
+    try {
+        finish();
+    } catch (...) {
+        // Nothing to report to from a destructor
+    }
+}
+
+void TaskWriter::writeHeader() {
+    switch (format) {
+        case Format::Table:
+            appendColumn(buffer, "ID", IdWidth);
+            appendColumn(buffer, "Status", StatusWidth);
+            appendColumn(buffer, "Due", DueWidth);
+            appendColumn(buffer, "Reminder", ReminderWidth);
+            buffer += "Description\n";
+            break;
+        case Format::Csv:
+            buffer += "id,description,reminder_minutes,created_at,due_date,completed\r\n";
+            break;
+        case Format::Json:
+            buffer += '[';
+            break;
+    }
+}
+
+void TaskWriter::write(const TaskRow& row) {
+    switch (format) {
+        case Format::Table: {
+            appendColumn(buffer, std::to_string(row.id), IdWidth);
+            appendColumn(buffer, row.completed ? "Completed" : "Pending", StatusWidth);
+            size_t start = buffer.size();
+            TimeFormat::appendLocal(buffer, fromSeconds(row.dueDate), false);
+            buffer.append(DueWidth - (buffer.size() - start), ' ');
+            appendColumn(buffer, std::to_string(row.reminderMinutes) + " min", ReminderWidth);
+            buffer += row.description;
+            buffer += '\n';
+            break;
+        }
+        case Format::Csv:
+            buffer += std::to_string(row.id);
+            buffer += ',';
+            appendCsvField(buffer, row.description);
+            buffer += ',';
+            buffer += std::to_string(row.reminderMinutes);
+            buffer += ',';
+            TimeFormat::appendIsoUtc(buffer, fromSeconds(row.createdAt));
+            buffer += ',';
+            TimeFormat::appendIsoUtc(buffer, fromSeconds(row.dueDate));
+            buffer += row.completed ? ",true\r\n" : ",false\r\n";
+            break;
+        case Format::Json:
+            buffer += count == 0 ? "\n{\"id\":" : ",\n{\"id\":";
+            buffer += std::to_string(row.id);
+            buffer += ",\"description\":";
+            Notification::appendJsonString(buffer, row.description);
+            buffer += ",\"reminder_minutes\":";
+            buffer += std::to_string(row.reminderMinutes);
+            buffer += ",\"created_at\":\"";
+            TimeFormat::appendIsoUtc(buffer, fromSeconds(row.createdAt));
+            buffer += "\",\"due_date\":\"";
+            TimeFormat::appendIsoUtc(buffer, fromSeconds(row.dueDate));
+            buffer += row.completed ? "\",\"completed\":true}" : "\",\"completed\":false}";
+            break;
+    }
+    ++count;
+
+    if (buffer.size() >= FlushThreshold) {
+        writeBuffer();
+    }
+}
+
+void TaskWriter::finish() {
+    if (finished) {
+        return;
+    }
+    finished = true;
+
+    switch (format) {
+        case Format::Table:
+            buffer += count == 1 ? "1 task\n" : std::to_string(count) + " tasks\n";
+            break;
+        case Format::Csv:
+            break;
+        case Format::Json:
+            buffer += count == 0 ? "]\n" : "\n]\n";
+            break;
+    }
+    writeBuffer();
+    out.flush();
+}
+
+size_t TaskWriter::getCount() const {
+    return count;
+}
+
+void TaskWriter::writeBuffer() {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
\ No newline at end of file
@@ -0,0 +1,559 @@
+#include "../include/core/TimeFormat.hpp"
+#include <algorithm>
+#include <climits>
+
+namespace {
+    constexpr long long SecondsPerDay = 86400;
+    // Offsets only change on quarter-hour boundaries (UTC) in current timezones
+    constexpr long long OffsetBlockSeconds = 900;
+
+    constexpr const char* Weekdays[] = {"Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"};  // from 1970-01-01
+    constexpr const char* Months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                      "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+    long long floorDiv(long long value, long long divisor) {
+        long long quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    long long epochSeconds(TimeFormat::TimePoint time) {
+        return floorDiv(std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count(), 1000);
+    }
+
+    // Proleptic Gregorian conversions between days since 1970-01-01 and dates
+    struct CivilDate {
+        long long year;
+        unsigned month;  // 1-12
+        unsigned day;    // 1-31
+    };
+
+    CivilDate civilFromDays(long long days) {
+        days += 719468;
+        long long era = floorDiv(days, 146097);
+        long long dayOfEra = days - era * 146097;
+        long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        long long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        long long monthIndex = (5 * dayOfYear + 2) / 153;
+        unsigned day = static_cast<unsigned>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+        unsigned month = static_cast<unsigned>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+        return CivilDate{yearOfEra + era * 400 + (month <= 2), month, day};
+    }
+
+    long long daysFromCivil(long long year, unsigned month, unsigned day) {
+        year -= month <= 2;
+        long long era = floorDiv(year, 400);
+        long long yearOfEra = year - era * 400;
+        long long dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    void appendTwoDigits(std::string& out, unsigned value) {
+        out += static_cast<char>('0' + value / 10);
+        out += static_cast<char>('0' + value % 10);
+    }
+
+    void appendYear(std::string& out, long long year) {
+        if (year < 0) {
+            out += '-';
+            year = -year;
+        }
+        std::string digits = std::to_string(year);
+        out.append(digits.size() < 4 ? 4 - digits.size() : 0, '0');
+        out += digits;
+    }
+
+    // "YYYY-MM-DD" and the RFC 2822 "Www, DD Mon YYYY" of one day
+    struct DayText {
+        long long day{LLONG_MIN};
+        std::string iso;
+        std::string rfc2822;
+    };
+
+    const DayText& dayText(long long day) {
+        // A few days, so rows alternating between a created and a due date hit
+        thread_local DayText cache[4];
+        DayText& cached = cache[static_cast<size_t>(day) & 3];
+        if (cached.day != day) {
+            CivilDate date = civilFromDays(day);
+            cached.day = day;
+            cached.iso.clear();
+            appendYear(cached.iso, date.year);
+            cached.iso += '-';
+            appendTwoDigits(cached.iso, date.month);
+            cached.iso += '-';
+            appendTwoDigits(cached.iso, date.day);
+
+            cached.rfc2822 = Weekdays[static_cast<size_t>(day - floorDiv(day, 7) * 7)];
+            cached.rfc2822 += ", ";
+            appendTwoDigits(cached.rfc2822, date.day);
+            cached.rfc2822 += ' ';
+            cached.rfc2822 += Months[date.month - 1];
+            cached.rfc2822 += ' ';
+            appendYear(cached.rfc2822, date.year);
+        }
+        return cached;
+    }
+
+    void appendClock(std::string& out, long long secondOfDay, bool withSeconds) {
+        appendTwoDigits(out, static_cast<unsigned>(secondOfDay / 3600));
+        out += ':';
+        appendTwoDigits(out, static_cast<unsigned>(secondOfDay / 60 % 60));
+        if (withSeconds) {
+            out += ':';
+            appendTwoDigits(out, static_cast<unsigned>(secondOfDay % 60));
+        }
+    }
+
+    std::tm toLocalTm(long long seconds) {
+        std::time_t time = static_cast<std::time_t>(seconds);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        return tm;
+    }
+
+    long localOffset(long long seconds) {
+        struct OffsetCache {
+            long long block{LLONG_MIN};
+            long offset{0};
+        };
+        // A few blocks, so converting local times (which probes around the
+        // instant) and formatting nearby stamps keep hitting
+        thread_local OffsetCache cache[8];
+
+        long long block = floorDiv(seconds, OffsetBlockSeconds);
+        OffsetCache& cached = cache[static_cast<size_t>(block) & 7];
+        if (cached.block != block) {
+            // The broken-down local time read back as if it were UTC is
+            // ahead of the real instant by exactly the offset
+            std::tm tm = toLocalTm(seconds);
+            long long localSeconds = daysFromCivil(tm.tm_year + 1900LL, static_cast<unsigned>(tm.tm_mon + 1),
+                                                   static_cast<unsigned>(tm.tm_mday)) * SecondsPerDay +
+                                     tm.tm_hour * 3600LL + tm.tm_min * 60LL + tm.tm_sec;
+            cached.block = block;
+            cached.offset = static_cast<long>(localSeconds - seconds);
+        }
+        return cached.offset;
+    }
+
+    // Longest backward offset change looked for when a local time repeats
+    constexpr long long MaxOffsetChange = 3 * 3600;
+
+    // Local wall-clock seconds back to an instant, as mktime does for a
+    // skipped time (moved forward by the change); a repeated time is the
+    // first occurrence
+    long long epochFromLocal(long long local) {
+        long offset = localOffset(local - localOffset(local));
+        long long seconds = local - offset;
+        long actual = localOffset(seconds);
+        if (actual != offset) {
+            return local - std::min(offset, actual);
+        }
+        long before = localOffset(seconds - MaxOffsetChange);
+        if (before > offset && localOffset(local - before) == before) {
+            return local - before;
+        }
+        return seconds;
+    }
+
+    const char* const WeekdayNames[] = {"sunday", "monday", "tuesday", "wednesday",
+                                        "thursday", "friday", "saturday"};
+
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    char toLower(char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    unsigned daysInMonth(long long year, unsigned month) {
+        static constexpr unsigned Days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        return month == 2 && leap ? 29 : Days[month - 1];
+    }
+
+    // Reads the input left to right; every step leaves the position
+    // unchanged when it does not match
+    struct Cursor {
+        std::string_view text;
+        size_t pos{0};
+
+        bool done() const { return pos == text.size(); }
+        char peek() const { return done() ? '\0' : text[pos]; }
+
+        bool accept(char c) {
+            if (peek() != c) {
+                return false;
+            }
+            ++pos;
+            return true;
+        }
+
+        void skipSpaces() {
+            while (peek() == ' ' || peek() == '\t') {
+                ++pos;
+            }
+        }
+
+        // Exactly count digits
+        bool fixed(unsigned count, long long& value) {
+            if (text.size() - pos < count) {
+                return false;
+            }
+            long long result = 0;
+            for (unsigned i = 0; i < count; ++i) {
+                char c = text[pos + i];
+                if (!isDigit(c)) {
+                    return false;
+                }
+                result = result * 10 + (c - '0');
+            }
+            value = result;
+            pos += count;
+            return true;
+        }
+
+        // One to maxDigits digits
+        bool number(long long& value, unsigned maxDigits) {
+            size_t start = pos;
+            long long result = 0;
+            while (isDigit(peek()) && pos - start < maxDigits) {
+                result = result * 10 + (text[pos] - '0');
+                ++pos;
+            }
+            if (pos == start || isDigit(peek())) {
+                pos = start;
+                return false;
+            }
+            value = result;
+            return true;
+        }
+
+        // A run of letters, lower-cased into buffer; empty when there is none
+        std::string_view word(char* buffer, size_t size) {
+            size_t start = pos;
+            size_t length = 0;
+            while (!done()) {
+                char c = toLower(text[pos]);
+                if (c < 'a' || c > 'z') {
+                    break;
+                }
+                if (length == size) {
+                    pos = start;
+                    return {};
+                }
+                buffer[length++] = c;
+                ++pos;
+            }
+            return std::string_view(buffer, length);
+        }
+    };
+
+    // "HH:MM[:SS]" as seconds into the day
+    bool parseClock(Cursor& in, long long& secondOfDay, const char*& error) {
+        long long hour = 0;
+        long long minute = 0;
+        long long second = 0;
+        if (!in.number(hour, 2) || !in.accept(':') || !in.fixed(2, minute)) {
+            error = "Invalid time, expected HH:MM";
+            return false;
+        }
+        if (in.accept(':') && !in.fixed(2, second)) {
+            error = "Invalid seconds, expected HH:MM:SS";
+            return false;
+        }
+        if (hour > 23) {
+            error = "Hour must be between 0 and 23";
+            return false;
+        }
+        if (minute > 59) {
+            error = "Minute must be between 0 and 59";
+            return false;
+        }
+        if (second > 59) {
+            error = "Second must be between 0 and 59";
+            return false;
+        }
+        secondOfDay = hour * 3600 + minute * 60 + second;
+        return true;
+    }
+
+    // "+N" minutes or "+N<unit>..." in milliseconds
+    bool parseRelative(Cursor& in, long long& milliseconds, const char*& error) {
+        long long total = 0;
+        bool bareNumber = true;
+        do {
+            long long amount = 0;
+            if (!in.number(amount, 9)) {
+                error = "Invalid relative time, expected +N with an optional unit s, m, h, d or w";
+                return false;
+            }
+            long long unit = 60;
+            char unitText[3];
+            std::string_view name = in.word(unitText, sizeof(unitText));
+            if (!name.empty()) {
+                bareNumber = false;
+                if (name == "s") {
+                    unit = 1;
+                } else if (name == "m" || name == "min") {
+                    unit = 60;
+                } else if (name == "h") {
+                    unit = 3600;
+                } else if (name == "d") {
+                    unit = SecondsPerDay;
+                } else if (name == "w") {
+                    unit = 7 * SecondsPerDay;
+                } else {
+                    error = "Unknown relative time unit, use s, m, h, d or w";
+                    return false;
+                }
+            } else if (!bareNumber || !in.done()) {
+                error = "Invalid relative time, every amount needs a unit as in +1h30m";
+                return false;
+            }
+            total += amount * unit;
+            if (total > 100LL * 366 * SecondsPerDay) {
+                error = "Relative time is too far ahead";
+                return false;
+            }
+        } while (!in.done());
+        milliseconds = total * 1000;
+        return true;
+    }
+
+    // "YYYY-MM-DD..." in milliseconds since the epoch
+    bool parseIso(Cursor& in, long long& milliseconds, const char*& error) {
+        long long year = 0;
+        long long month = 0;
+        long long day = 0;
+        if (!in.fixed(4, year) || !in.accept('-') || !in.number(month, 2) || !in.accept('-') ||
+            !in.number(day, 2)) {
+            error = "Invalid date, expected YYYY-MM-DD";
+            return false;
+        }
+        if (month < 1 || month > 12) {
+            error = "Month must be between 1 and 12";
+            return false;
+        }
+        if (day < 1 || day > daysInMonth(year, static_cast<unsigned>(month))) {
+            error = "Day is not in that month";
+            return false;
+        }
+
+        long long secondOfDay = 0;
+        long long fraction = 0;
+        if (!in.done()) {
+            if (!in.accept('T') && !in.accept('t')) {
+                in.skipSpaces();
+            }
+            if (!parseClock(in, secondOfDay, error)) {
+                return false;
+            }
+            // Milliseconds are kept, finer digits are ignored
+            if (in.accept('.') || in.accept(',')) {
+                long long scale = 100;
+                if (!isDigit(in.peek())) {
+                    error = "Invalid fraction of a second";
+                    return false;
+                }
+                while (isDigit(in.peek())) {
+                    fraction += (in.peek() - '0') * scale;
+                    scale /= 10;
+                    ++in.pos;
+                }
+            }
+        }
+
+        long long local = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) *
+                          SecondsPerDay + secondOfDay;
+        long long seconds = 0;
+        if (in.accept('Z') || in.accept('z')) {
+            seconds = local;
+        } else if (in.peek() == '+' || in.peek() == '-') {
+            long long sign = in.peek() == '-' ? -1 : 1;
+            ++in.pos;
+            long long offsetHours = 0;
+            long long offsetMinutes = 0;
+            if (!in.fixed(2, offsetHours)) {
+                error = "Invalid UTC offset, expected +HH:MM";
+                return false;
+            }
+            if (in.accept(':') ? !in.fixed(2, offsetMinutes) : (!in.done() && !in.fixed(2, offsetMinutes))) {
+                error = "Invalid UTC offset, expected +HH:MM";
+                return false;
+            }
+            if (offsetHours > 23 || offsetMinutes > 59) {
+                error = "UTC offset is out of range";
+                return false;
+            }
+            seconds = local - sign * (offsetHours * 3600 + offsetMinutes * 60);
+        } else {
+            seconds = epochFromLocal(local);
+        }
+        milliseconds = seconds * 1000 + fraction;
+        return true;
+    }
+
+    // "today", "tomorrow" or "[next] <weekday>", then an optional clock time
+    bool parseNamedDay(Cursor& in, long long nowSeconds, long long& milliseconds, const char*& error) {
+        char buffer[9];
+        std::string_view name = in.word(buffer, sizeof(buffer));
+        bool next = false;
+        if (name == "next") {
+            next = true;
+            in.skipSpaces();
+            name = in.word(buffer, sizeof(buffer));
+        }
+
+        long long localNow = nowSeconds + localOffset(nowSeconds);
+        long long today = floorDiv(localNow, SecondsPerDay);
+        long long day = 0;
+        int weekday = -1;
+        if (name == "today" && !next) {
+            day = today;
+        } else if (name == "tomorrow" && !next) {
+            day = today + 1;
+        } else {
+            for (int i = 0; i < 7 && name.size() >= 3; ++i) {
+                if (std::string_view(WeekdayNames[i]).starts_with(name)) {
+                    weekday = i;
+                    break;
+                }
+            }
+            if (weekday < 0) {
+                error = "Unknown day, use today, tomorrow or a weekday name";
+                return false;
+            }
+            long long todayWeekday = today + 4 - floorDiv(today + 4, 7) * 7;  // 1970-01-01 was a Thursday
+            day = today + (weekday - todayWeekday + 7) % 7;
+            if (next && day == today) {
+                day += 7;
+            }
+        }
+
+        long long secondOfDay = 0;
+        in.skipSpaces();
+        if (!in.done()) {
+            if (!parseClock(in, secondOfDay, error)) {
+                return false;
+            }
+        }
+
+        long long seconds = epochFromLocal(day * SecondsPerDay + secondOfDay);
+        // A weekday that is already over today means next week
+        if (weekday >= 0 && seconds <= nowSeconds) {
+            seconds = epochFromLocal((day + 7) * SecondsPerDay + secondOfDay);
+        }
+        milliseconds = seconds * 1000;
+        return true;
+    }
+}
+
+namespace TimeFormat {
+
+void appendLocal(std::string& out, TimePoint time, bool withSeconds) {
+    // "YYYY-MM-DD HH:MM" of the current local minute
+    struct MinuteCache {
+        long long minute{LLONG_MIN};
+        std::string prefix;
+    };
+    thread_local MinuteCache cached;
+
+    long long seconds = epochSeconds(time);
+    long long local = seconds + localOffset(seconds);
+    long long minute = floorDiv(local, 60);
+    if (cached.minute != minute) {
+        long long day = floorDiv(local, SecondsPerDay);
+        cached.minute = minute;
+        cached.prefix = dayText(day).iso;
+        cached.prefix += ' ';
+        appendClock(cached.prefix, local - day * SecondsPerDay, false);
+    }
+
+    out += cached.prefix;
+    if (withSeconds) {
+        out += ':';
+        appendTwoDigits(out, static_cast<unsigned>(local - minute * 60));
+    }
+}
+
+std::string local(TimePoint time, bool withSeconds) {
+    std::string text;
+    appendLocal(text, time, withSeconds);
+    return text;
+}
+
+void appendIsoUtc(std::string& out, TimePoint time) {
+    long long seconds = epochSeconds(time);
+    long long day = floorDiv(seconds, SecondsPerDay);
+    out += dayText(day).iso;
+    out += 'T';
+    appendClock(out, seconds - day * SecondsPerDay, true);
+    out += 'Z';
+}
+
+void appendRfc2822(std::string& out, TimePoint time) {
+    long long seconds = epochSeconds(time);
+    long long day = floorDiv(seconds, SecondsPerDay);
+    out += dayText(day).rfc2822;
+    out += ' ';
+    appendClock(out, seconds - day * SecondsPerDay, true);
+    out += " +0000";
+}
+
+std::tm localTm(TimePoint time) {
+    return toLocalTm(epochSeconds(time));
+}
+
+long utcOffset(TimePoint time) {
+    return localOffset(epochSeconds(time));
+}
+
+long long localYear(TimePoint time) {
+    long long seconds = epochSeconds(time);
+    return civilFromDays(floorDiv(seconds + localOffset(seconds), SecondsPerDay)).year;
+}
+
+bool parse(std::string_view text, TimePoint now, TimePoint& out, const char** error) {
+    const char* failure = nullptr;
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    Cursor in{text};
+    in.skipSpaces();
+
+    long long nowMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    long long milliseconds = 0;
+    bool parsed = false;
+    if (in.done()) {
+        failure = "Empty date/time";
+    } else if (in.accept('+')) {
+        long long offset = 0;
+        parsed = parseRelative(in, offset, failure);
+        milliseconds = nowMilliseconds + offset;
+    } else if (isDigit(in.peek())) {
+        parsed = parseIso(in, milliseconds, failure);
+    } else {
+        parsed = parseNamedDay(in, floorDiv(nowMilliseconds, 1000), milliseconds, failure);
+    }
+
+    if (parsed && !in.done()) {
+        parsed = false;
+        failure = "Unexpected text after the date/time";
+    }
+    if (!parsed) {
+        if (error) {
+            *error = failure;
+        }
+        return false;
+    }
+    out = TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::milliseconds(milliseconds)));
+    return true;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,330 @@
+#include "../include/notifications/WebhookNotification.hpp"
+#include "../include/database/Exceptions.hpp"
+#include <curl/curl.h>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    size_t discardResponse(char*, size_t size, size_t count, void*) {
+        return size * count;
+    }
+
+    void ensureCurlInitialized() {
+        static std::once_flag initFlag;
+        std::call_once(initFlag, [] {
+            if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+                throw NotificationException("Failed to initialize libcurl");
+            }
+        });
+    }
+}
+
+WebhookNotification::WebhookNotification(std::string webhookUrl) {
+    if (!setUrl(webhookUrl)) {
+        throw NotificationException("Invalid webhook URL: " + webhookUrl);
+    }
+
+    ensureCurlInitialized();
+    multi = curl_multi_init();
+    if (!multi) {
+        throw NotificationException("Failed to create webhook event loop");
+    }
+    // Idle connections stay cached for keep-alive, one per possible request
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(maxInFlight));
+
+    loopThread = std::thread(&WebhookNotification::runEventLoop, this);
+}
+
+WebhookNotification::~WebhookNotification() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    curl_multi_wakeup(multi);
+
+    // Queued and in-flight requests finish (or time out) before the loop exits
+    if (loopThread.joinable()) {
+        loopThread.join();
+    }
+
+    for (CURL* handle : idleHandles) {
+        curl_easy_cleanup(handle);
+    }
+    curl_multi_cleanup(multi);
+}
+
+void WebhookNotification::sendNotification(const Task& task, const std::string& message) {
+    Payload payload{idempotencyKey(task), buildPayload(task, message), task, message};
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            throw NotificationException("Webhook notification is shutting down");
+        }
+        if (queue.size() >= maxQueued) {
+            throw NotificationException("Webhook queue is full (" + std::to_string(maxQueued) + " requests)");
+        }
+        if (queue.empty() && active.empty()) {
+            firstRequest = std::chrono::steady_clock::now();
+        }
+        queue.push_back(std::move(payload));
+    }
+    curl_multi_wakeup(multi);
+}
+
+bool WebhookNotification::reportsOutcomes() const {
+    return true;
+}
+
+std::string WebhookNotification::buildPayload(const Task& task, const std::string& message) const {
+    std::string body;
+    body.reserve(256);
+    body += "{\"task_id\":";
+    body += std::to_string(task.getId());
+    body += ",\"description\":";
+    appendJsonString(body, task.getDescription());
+    body += ",\"due\":\"";
+    appendIsoTimestamp(body, task.getDueDate());
+    body += "\",\"reminder_minutes\":";
+    body += std::to_string(task.getReminderMinutes());
+    body += ",\"completed\":";
+    body += task.isCompleted() ? "true" : "false";
+    body += ",\"prefix\":";
+    appendJsonString(body, notificationPrefix);
+    body += ",\"message\":";
+    appendJsonString(body, message);
+    body += ",\"idempotency_key\":\"";
+    appendIdempotencyKey(body, task);
+    body += "\"}";
+    return body;
+}
+
+void WebhookNotification::runEventLoop() {
+    while (true) {
+        std::vector<Payload> unstarted;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping && queue.empty() && active.empty()) {
+                break;
+            }
+            if (connectionLimitChanged) {
+                curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(maxInFlight));
+                connectionLimitChanged = false;
+            }
+
+            // Top up to the in-flight limit from the queue
+            while (active.size() < maxInFlight && !queue.empty()) {
+                Payload payload = std::move(queue.front());
+                queue.pop_front();
+                if (!startRequest(payload)) {
+                    unstarted.push_back(std::move(payload));
+                }
+            }
+        }
+
+        for (const auto& payload : unstarted) {
+            NotificationException error("Webhook request dropped: cannot create handle");
+            reportOutcome(payload.task, payload.message, &error);
+        }
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        bool finished = false;
+        CURLMsg* msg;
+        int remaining = 0;
+        while ((msg = curl_multi_info_read(multi, &remaining))) {
+            if (msg->msg == CURLMSG_DONE) {
+                finishRequest(msg->easy_handle, msg->data.result);
+                finished = true;
+            }
+        }
+
+        // Freed slots are refilled straight away; otherwise sleep until
+        // socket activity, a curl timeout, or curl_multi_wakeup
+        if (!finished) {
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+    }
+}
+
+// Caller holds mutex; false if the request could not be started
+bool WebhookNotification::startRequest(Payload& payload) {
+    CURL* handle;
+    if (!idleHandles.empty()) {
+        handle = idleHandles.back();
+        idleHandles.pop_back();
+        curl_easy_reset(handle);
+    } else {
+        handle = curl_easy_init();
+        if (!handle) {
+            ++failed;
+            return false;
+        }
+    }
+
+    auto* request = new Request{handle, std::move(payload.body), nullptr, std::chrono::steady_clock::now(),
+                                std::move(payload.task), std::move(payload.message)};
+
+    // Receivers use the key to drop a reminder that fires again after a restart
+    std::string keyHeader = "Idempotency-Key: " + payload.idempotencyKey;
+    request->headers = curl_slist_append(request->headers, "Content-Type: application/json");
+    request->headers = curl_slist_append(request->headers, keyHeader.c_str());
+
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, request->headers);
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDS, request->body.c_str());
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request->body.size()));
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, discardResponse);
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout.count()));
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, request);
+
+    curl_multi_add_handle(multi, handle);
+    active.push_back(request);
+    return true;
+}
+
+void WebhookNotification::finishRequest(CURL* handle, int result) {
+    Request* request = nullptr;
+    curl_easy_getinfo(handle, CURLINFO_PRIVATE, &request);
+
+    long status = 0;
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &status);
+    curl_multi_remove_handle(multi, handle);
+
+    auto now = std::chrono::steady_clock::now();
+    bool success = result == CURLE_OK && status >= 200 && status < 300;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (success) {
+            ++delivered;
+            auto latency = now - request->started;
+            totalLatency += latency;
+            maxLatency = std::max(maxLatency, latency);
+        } else {
+            ++failed;
+        }
+        lastCompletion = now;
+
+        active.erase(std::remove(active.begin(), active.end(), request), active.end());
+        // The handle goes back to the pool; connections stay in the multi cache
+        idleHandles.push_back(handle);
+
+        if (queue.empty() && active.empty()) {
+            idle.notify_all();
+        }
+    }
+
+    if (success) {
+        reportOutcome(request->task, request->message, nullptr);
+    } else {
+        NotificationException error("Webhook delivery to " + url + " failed: " +
+                                    (result != CURLE_OK ? curl_easy_strerror(static_cast<CURLcode>(result))
+                                                        : "HTTP " + std::to_string(status)));
+        reportOutcome(request->task, request->message, &error);
+    }
+    curl_slist_free_all(request->headers);
+    delete request;
+}
+
+bool WebhookNotification::setUrl(const std::string& newUrl) {
+    if (newUrl.rfind("http://", 0) != 0 && newUrl.rfind("https://", 0) != 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    url = newUrl;
+    return true;
+}
+
+bool WebhookNotification::setTimeout(const std::chrono::milliseconds& newTimeout) {
+    if (newTimeout.count() <= 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    timeout = newTimeout;
+    return true;
+}
+
+bool WebhookNotification::setMaxInFlight(size_t maxRequests) {
+    if (maxRequests == 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        maxInFlight = maxRequests;
+        connectionLimitChanged = true;
+    }
+    curl_multi_wakeup(multi);
+    return true;
+}
+
+bool WebhookNotification::setMaxQueued(size_t maxRequests) {
+    if (maxRequests == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    maxQueued = maxRequests;
+    return true;
+}
+
+std::string WebhookNotification::getUrl() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return url;
+}
+
+std::chrono::milliseconds WebhookNotification::getTimeout() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return timeout;
+}
+
+size_t WebhookNotification::getMaxInFlight() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxInFlight;
+}
+
+size_t WebhookNotification::getMaxQueued() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxQueued;
+}
+
+WebhookNotification::Stats WebhookNotification::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Stats stats;
+    stats.delivered = delivered;
+    stats.failed = failed;
+    stats.inFlight = active.size();
+    stats.queued = queue.size();
+    if (delivered > 0) {
+        stats.averageLatencyMs = std::chrono::duration<double, std::milli>(totalLatency).count() / delivered;
+    }
+    stats.maxLatencyMs = std::chrono::duration<double, std::milli>(maxLatency).count();
+
+    double seconds = std::chrono::duration<double>(lastCompletion - firstRequest).count();
+    if (seconds > 0.0) {
+        stats.requestsPerSecond = (delivered + failed) / seconds;
+    }
+    return stats;
+}
+
+void WebhookNotification::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    delivered = 0;
+    failed = 0;
+    totalLatency = {};
+    maxLatency = {};
+    firstRequest = std::chrono::steady_clock::now();
+    lastCompletion = firstRequest;
+}
+
+bool WebhookNotification::waitUntilIdle(const std::chrono::milliseconds& waitTimeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return idle.wait_for(lock, waitTimeout, [this] { return queue.empty() && active.empty(); });
+}
\ No newline at end of file
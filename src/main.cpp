@@ -11,16 +11,14 @@
 #include "../include/notifications/EmailNotification.hpp"
 #include "../include/database/Exceptions.hpp"
 #include "../include/core/CLI.hpp"
+#include "../include/core/Daemon.hpp"
 
 // Helper function to print task details
 void printTask(const Task& task) {
     std::cout << "Task #" << task.getId() << ": " << task.getDescription() << std::endl;
     
-    auto dueTime = std::chrono::system_clock::to_time_t(task.getDueDate());
-    std::cout << "Due: " << std::ctime(&dueTime);
-    
-    auto reminderTime = std::chrono::system_clock::to_time_t(task.getReminderTime());
-    std::cout << "Reminder: " << std::ctime(&reminderTime);
+    std::cout << "Due: " << TimeFormat::local(task.getDueDate()) << std::endl;
+    std::cout << "Reminder: " << TimeFormat::local(task.getReminderTime()) << std::endl;
     
     std::cout << "Status: " << (task.isCompleted() ? "Completed" : "Pending") << std::endl;
     std::cout << "--------------------------" << std::endl;
@@ -36,18 +34,60 @@ void handleError(const std::error_code& error) {
 int main(int argc, char* argv[]) {
     std::string dbPath = "tasks.db";
     bool cliMode = false;
+    bool batchMode = false;
+    std::string batchSource;
+    bool daemonMode = false;
+    bool clientMode = false;
+    std::string socketPath;
     
     // Process command line arguments
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         if (arg == "--cli") {
             cliMode = true;
+        } else if (arg == "--batch") {
+            if (i + 1 >= argc) {
+                std::cerr << "Usage: task_scheduler --batch <file|-> [database]" << std::endl;
+                return 2;
+            }
+            batchMode = true;
+            batchSource = argv[++i];
+        } else if (arg == "--daemon") {
+            daemonMode = true;
+        } else if (arg == "--client") {
+            clientMode = true;
+        } else if (arg == "--socket") {
+            if (i + 1 >= argc) {
+                std::cerr << "Usage: task_scheduler --daemon|--client [--socket <path>] [database]" << std::endl;
+                return 2;
+            }
+            socketPath = argv[++i];
         } else {
             dbPath = arg;
         }
     }
     
     try {
+        // Batch output is read by other programs, so only results go to stdout
+        if (batchMode) {
+            std::filesystem::path dbFilePath = std::filesystem::absolute(dbPath);
+            std::filesystem::create_directories(dbFilePath.parent_path());
+            return runBatch(dbFilePath.string(), batchSource);
+        }
+
+        // The daemon listens next to its database unless told otherwise
+        if (daemonMode || clientMode) {
+            std::filesystem::path dbFilePath = std::filesystem::absolute(dbPath);
+            if (socketPath.empty()) {
+                socketPath = dbFilePath.string() + ".sock";
+            }
+            if (clientMode) {
+                return runClient(socketPath);
+            }
+            std::filesystem::create_directories(dbFilePath.parent_path());
+            return runDaemon(dbFilePath.string(), socketPath);
+        }
+
         std::cout << "Task Management Application" << std::endl;
         std::cout << "==========================" << std::endl;
 
@@ -87,13 +127,19 @@ int main(int argc, char* argv[]) {
             runCLI(dbPath);
         } else {
             // Get user's home directory for the example
-            std::string homeDir = std::getenv("USERPROFILE");
+            const char* home = std::getenv("USERPROFILE");
+            if (!home) {
+                home = std::getenv("HOME");
+            }
+            std::string homeDir = home ? home : ".";
             std::filesystem::path examplePath = std::filesystem::path(homeDir) / "TaskScheduler" / "tasks.db";
         
             std::cout << "Please use --cli flag to interact with the application." << std::endl;
             std::cout << "Usage examples:" << std::endl;
             std::cout << "    .\\task_scheduler.exe --cli" << std::endl;
             std::cout << "    .\\task_scheduler.exe --cli \"" << examplePath.string() << "\"" << std::endl;
+            std::cout << "    .\\task_scheduler.exe --batch commands.txt \"" << examplePath.string() << "\"" << std::endl;
+            std::cout << "    ./task_scheduler --daemon tasks.db   and   echo list | ./task_scheduler --client tasks.db" << std::endl;
             std::cout << std::endl;
             std::cout << "Current database path: '" << std::filesystem::absolute(dbPath).string() << "'" << std::endl;
         }